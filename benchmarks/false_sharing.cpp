@@ -0,0 +1,54 @@
+// Tracker counter false sharing benchmark.
+//
+// Every thread hammers its own counter. Packed SafeNumeric counters share cache lines
+// the way the tracker statics used to. SafeAlignedNumeric gives each counter its own
+// line. The gap shows once the threads span several cores, so run it with 32 or more.
+//
+// Build: g++ -std=c++17 -O2 -pthread -I.. false_sharing.cpp -o false_sharing
+// Usage: ./false_sharing [max_threads] [increments_per_thread]
+
+#include "memory.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using PackedCounter = SafeNumeric<memory_uint64_t, ThreadSafetyPolicy::STD_ATOMIC>;
+using AlignedCounter = SafeAlignedNumeric<memory_uint64_t, ThreadSafetyPolicy::STD_ATOMIC,
+        AtomicOrderPolicy::ACQUIRE_RELEASE, DefaultConfig::CACHE_LINE_SIZE>;
+
+template<typename Counter>
+static double run(int p_threads, int p_increments) {
+    std::unique_ptr<Counter[]> counters(new Counter[p_threads]);
+    std::vector<std::thread> threads;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < p_threads; i++) {
+        threads.emplace_back([&counters, i, p_increments]() {
+            for (int k = 0; k < p_increments; k++) {
+                counters[i].increment();
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return double(p_threads) * p_increments / seconds / 1e6;
+}
+
+int main(int argc, char** argv) {
+    const int max_threads = argc > 1 ? std::atoi(argv[1]) : 64;
+    const int increments = argc > 2 ? std::atoi(argv[2]) : 2000000;
+
+    std::printf("%8s %16s %16s\n", "threads", "packed Mops/s", "aligned Mops/s");
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        const double packed = run<PackedCounter>(threads, increments);
+        const double aligned = run<AlignedCounter>(threads, increments);
+        std::printf("%8d %16.1f %16.1f\n", threads, packed, aligned);
+    }
+    return 0;
+}
@@ -0,0 +1,112 @@
+// Producer/consumer benchmark for cross-thread frees.
+//
+// Each producer allocates small blocks and hands them to its own consumer, which frees
+// them. With a pooled manager every free is remote and goes through the owner's queue.
+// Throughput should grow with the number of pairs instead of collapsing on a shared lock.
+//
+// Build: g++ -std=c++17 -O2 -pthread -I.. remote_free.cpp -o remote_free
+// Usage: ./remote_free [max_pairs] [blocks_per_producer]
+
+#include "memory.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using PooledMemory = MemoryManager<MemoryConfig<
+    false,
+    true,
+    false,
+    ThreadSafetyPolicy::STD_ATOMIC,
+    MemoryTrackingLevel::NONE,
+    MemoryAlignmentPolicy::STANDARD,
+    MemoryPaddingPolicy::NONE,
+    MemoryAllocationStrategy::POOLED,
+    MemoryErrorPolicy::SILENT>>;
+
+// Bounded single-producer single-consumer ring, one per pair
+struct Ring {
+    static constexpr memory_size_t CAPACITY = 4096;
+
+    alignas(64) std::atomic<memory_size_t> head{0};
+    alignas(64) std::atomic<memory_size_t> tail{0};
+    void* slots[CAPACITY];
+
+    bool push(void* p_ptr) {
+        const memory_size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == CAPACITY) {
+            return false;
+        }
+        slots[t % CAPACITY] = p_ptr;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    void* pop() {
+        const memory_size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        void* ptr = slots[h % CAPACITY];
+        head.store(h + 1, std::memory_order_release);
+        return ptr;
+    }
+};
+
+static void* const END_OF_STREAM = reinterpret_cast<void*>(1);
+
+template<typename M>
+static double run(int p_pairs, int p_blocks) {
+    std::vector<Ring> rings(p_pairs);
+    std::vector<std::thread> threads;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < p_pairs; i++) {
+        threads.emplace_back([&rings, i, p_blocks]() {
+            for (int k = 0; k < p_blocks; k++) {
+                void* ptr = M::alloc_static(64 + (k % 4) * 32);
+                *static_cast<int*>(ptr) = k;
+                while (!rings[i].push(ptr)) {
+                    std::this_thread::yield();
+                }
+            }
+            while (!rings[i].push(END_OF_STREAM)) {
+                std::this_thread::yield();
+            }
+        });
+        threads.emplace_back([&rings, i]() {
+            for (;;) {
+                void* ptr = rings[i].pop();
+                if (!ptr) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                if (ptr == END_OF_STREAM) {
+                    break;
+                }
+                M::free_static(ptr);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    const int max_pairs = argc > 1 ? std::atoi(argv[1]) : 8;
+    const int blocks = argc > 2 ? std::atoi(argv[2]) : 200000;
+
+    std::printf("%6s %16s %16s\n", "pairs", "pooled Mops/s", "malloc Mops/s");
+    for (int pairs = 1; pairs <= max_pairs; pairs *= 2) {
+        const double pooled = run<PooledMemory>(pairs, blocks);
+        const double system = run<FastMemory>(pairs, blocks);
+        const double ops = double(pairs) * blocks / 1e6;
+        std::printf("%6d %16.1f %16.1f\n", pairs, ops / pooled, ops / system);
+    }
+    return 0;
+}
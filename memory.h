@@ -14,8 +14,11 @@
 #include "memory_config.h"
 
 // Memory management implementation
+#include "memory_os.h"
+#include "memory_pool.h"
 #include "memory_tracker.h"
 #include "memory_manager.h"
+#include "memory_object_pool.h"
 #include "memory_interface.h"
 
 // Version information
@@ -61,13 +61,15 @@ template<
     MemoryAlignmentPolicy AlignmentPolicy = MemoryAlignmentPolicy::STANDARD,
     MemoryPaddingPolicy PaddingPolicy = EnablePadding ? MemoryPaddingPolicy::DEBUG_ONLY : MemoryPaddingPolicy::NONE,
     MemoryAllocationStrategy AllocationStrategy = MemoryAllocationStrategy::SYSTEM_DEFAULT,
-    MemoryErrorPolicy ErrorPolicy = MEMORY_DEBUG_ENABLED ? MemoryErrorPolicy::ASSERT_DEBUG : MemoryErrorPolicy::LOG_ONLY
+    MemoryErrorPolicy ErrorPolicy = MEMORY_DEBUG_ENABLED ? MemoryErrorPolicy::ASSERT_DEBUG : MemoryErrorPolicy::LOG_ONLY,
+    bool EnableHooks = true
 >
 struct MemoryConfig {
     // Core features
     static constexpr bool ENABLE_TRACKING = EnableTracking;
     static constexpr bool ENABLE_ALIGNMENT = EnableAlignment;
     static constexpr bool ENABLE_PADDING = EnablePadding;
+    static constexpr bool ENABLE_HOOKS = EnableHooks; // false compiles runtime hooks and heap sampling out
     
     // Policies
     static constexpr ThreadSafetyPolicy THREAD_POLICY = ThreadPolicy;
@@ -113,7 +115,8 @@ using HighPerformanceConfig = MemoryConfig<
     MemoryAlignmentPolicy::NONE,        // AlignmentPolicy
     MemoryPaddingPolicy::NONE,          // PaddingPolicy
     MemoryAllocationStrategy::SYSTEM_DEFAULT, // AllocationStrategy
-    MemoryErrorPolicy::SILENT          // ErrorPolicy
+    MemoryErrorPolicy::SILENT,         // ErrorPolicy
+    false                               // EnableHooks
 >;
 
 using DebugConfig = MemoryConfig<
@@ -137,7 +140,8 @@ using EmbeddedConfig = MemoryConfig<
     MemoryAlignmentPolicy::NONE,        // AlignmentPolicy
     MemoryPaddingPolicy::NONE,          // PaddingPolicy
     MemoryAllocationStrategy::POOLED,   // AllocationStrategy
-    MemoryErrorPolicy::SILENT          // ErrorPolicy
+    MemoryErrorPolicy::SILENT,         // ErrorPolicy
+    false                               // EnableHooks
 >;
 
 using ThreadSafeConfig = MemoryConfig<
@@ -148,13 +152,13 @@ using ThreadSafeConfig = MemoryConfig<
     MemoryTrackingLevel::BASIC,         // TrackingLevel
     MemoryAlignmentPolicy::STANDARD,    // AlignmentPolicy
     MemoryPaddingPolicy::DEBUG_ONLY,    // PaddingPolicy
-    MemoryAllocationStrategy::SYSTEM_DEFAULT, // AllocationStrategy
+    MemoryAllocationStrategy::POOLED,   // AllocationStrategy
     MemoryErrorPolicy::ASSERT_DEBUG    // ErrorPolicy
 >;
 
 // Runtime configuration (for dynamic settings)
 struct MemoryRuntimeConfig {
-    // Hooks
+    // Hooks (only called by configs with ENABLE_HOOKS, after the operation; sizes are 0 where unknown)
     using AllocationHook = void(*)(void* ptr, memory_size_t size, const char* context);
     using DeallocationHook = void(*)(void* ptr, memory_size_t size, const char* context);
     using ReallocHook = void(*)(void* old_ptr, void* new_ptr, memory_size_t old_size, memory_size_t new_size, const char* context);
@@ -166,8 +170,12 @@ struct MemoryRuntimeConfig {
     ReallocHook realloc_hook = nullptr;
     
     // Memory limits
+    // Called when an allocation would exceed max_memory_usage; return true to retry it once
+    using OutOfMemoryHook = bool(*)(memory_size_t size, memory_size_t limit);
+    
     memory_size_t max_memory_usage = 0; // 0 = unlimited
     memory_size_t warning_threshold = 0; // 0 = no warning
+    OutOfMemoryHook out_of_memory_hook = nullptr;
     
     // Debug settings
     bool enable_leak_detection = false;
@@ -178,13 +186,24 @@ struct MemoryRuntimeConfig {
     memory_size_t small_allocation_threshold = 256;
     memory_size_t large_allocation_threshold = 1024 * 1024; // 1MB
     
+    // Heap sampling: mean bytes allocated between samples (0 = off, e.g. 512 KB for production profiles)
+    memory_size_t heap_sample_interval = 0;
+    
+    // Pooled strategies: free page runs idle this long are returned to the OS by the scavenger
+    memory_uint64_t scavenge_decay_ms = 10000; // 10s
+    
     // Singleton access
-    static MemoryRuntimeConfig& instance() {
-        static MemoryRuntimeConfig config;
-        return config;
+    static MEMORY_ALWAYS_INLINE MemoryRuntimeConfig& instance() {
+        return instance_;
     }
+
+private:
+    static MemoryRuntimeConfig instance_;
 };
 
+// Constant-initialized, so allocation paths read it without a static-init guard
+inline MemoryRuntimeConfig MemoryRuntimeConfig::instance_{};
+
 // Configuration validation helpers
 template<typename Config>
 constexpr bool validate_config() {
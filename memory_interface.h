@@ -10,8 +10,10 @@
 #include "platform_defines.h"
 #include "error_handling.h"
 #include "memory_manager.h"
+#include "memory_object_pool.h"
 #include <new>
 #include <type_traits>
+#include <vector>
 
 // Memory management macros (compatible with Godot)
 #define memalloc(m_size) Memory::alloc_static(m_size)
@@ -40,7 +42,10 @@ MEMORY_ALWAYS_INLINE T* _post_initialize(T* p_obj) {
 }
 
 // Object creation macros
-#define memnew(m_class) _post_initialize(::new ("") m_class)
+// The placement tag routes types opted in with MEMORY_OBJECT_POOLED to their pool. Its type
+// comes from the never-taken branch of a conditional rather than decltype, so the arguments
+// stay in an evaluated context (lambdas are allowed) but only run once.
+#define memnew(m_class) _post_initialize(::new (memory_new_tag(false ? ::new (MemoryNewProbe()) m_class : nullptr)) m_class)
 
 #define memnew_allocator(m_class, m_allocator) \
     _post_initialize(::new (m_allocator::alloc) m_class)
@@ -63,7 +68,16 @@ void memdelete(T* p_class) {
         p_class->~T();
     }
     
-    Memory::free_static(p_class, false);
+    if constexpr (memory_uses_object_pool_v<T>) {
+        ObjectPool<std::remove_cv_t<T>>::free(const_cast<std::remove_cv_t<T>*>(p_class));
+    }
+    else if constexpr (std::is_final_v<T> || !std::is_polymorphic_v<T>) {
+        // The dynamic type is T, so its size is known at compile time
+        Memory::free_sized_static(const_cast<std::remove_cv_t<T>*>(p_class), sizeof(T), false);
+    }
+    else {
+        Memory::free_static(p_class, false);
+    }
 }
 
 template<typename T, typename A>
@@ -182,6 +196,25 @@ void memdelete_arr(T* p_class) {
     Memory::free_static(ptr, true);
 }
 
+// Sized array deletion: p_elements must match the count passed to memnew_arr
+template<typename T>
+void memdelete_arr(T* p_class, memory_size_t p_elements) {
+    if (!p_class) {
+        return;
+    }
+
+    MEMORY_DEV_ASSERT(memarr_len(p_class) == p_elements);
+
+    // Destruct elements if needed
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        for (memory_size_t i = 0; i < p_elements; i++) {
+            p_class[i].~T();
+        }
+    }
+
+    Memory::free_sized_static(p_class, sizeof(T) * p_elements, true);
+}
+
 // Safe array deletion macro
 #define memdelete_arr_notnull(m_v) \
     do { \
@@ -206,7 +239,7 @@ namespace memory {
         
         template<typename... Args>
         static unique_ptr make(Args&&... args) {
-            T* ptr = _post_initialize(::new ("") T(std::forward<Args>(args)...));
+            T* ptr = _post_initialize(::new (memory_new_tag(static_cast<T*>(nullptr))) T(std::forward<Args>(args)...));
             return unique_ptr(ptr);
         }
         
@@ -277,7 +310,7 @@ namespace memory {
         
         ~unique_array() {
             if (ptr_) {
-                memdelete_arr(ptr_);
+                memdelete_arr(ptr_, size_);
             }
         }
         
@@ -291,7 +324,7 @@ namespace memory {
         unique_array& operator=(unique_array&& other) noexcept {
             if (this != &other) {
                 if (ptr_) {
-                    memdelete_arr(ptr_);
+                    memdelete_arr(ptr_, size_);
                 }
                 ptr_ = other.ptr_;
                 size_ = other.size_;
@@ -325,7 +358,7 @@ namespace memory {
         // Reset array
         void reset(memory_size_t count = 0) {
             if (ptr_) {
-                memdelete_arr(ptr_);
+                memdelete_arr(ptr_, size_);
             }
             if (count > 0) {
                 ptr_ = memnew_arr_template<T>(count);
@@ -372,6 +405,11 @@ namespace memory {
         return Memory::get_memory_stats();
     }
     
+    // Allocation counts by requested size, for tuning pool size classes
+    inline MemorySizeHistogram get_size_histogram() {
+        return Memory::get_size_histogram();
+    }
+    
     inline void reset_stats() {
         Memory::reset_memory_stats();
     }
@@ -380,6 +418,11 @@ namespace memory {
         Memory::dump_memory_allocations();
     }
     
+    // Live allocations picked by heap sampling (MemoryRuntimeConfig::heap_sample_interval)
+    inline std::vector<HeapSample> get_heap_samples() {
+        return MemoryHeapSampler::get_samples();
+    }
+    
     // Runtime configuration
     inline void set_error_handler(MemoryErrorHandler handler) {
         set_memory_error_handler(handler);
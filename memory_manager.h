@@ -12,6 +12,9 @@
 #include "thread_safe.h"
 #include "memory_config.h"
 #include "memory_tracker.h"
+#include "memory_pool.h"
+#include "memory_os.h"
+#include <atomic>
 #include <cstdlib>
 #include <cstring>
 #include <new>
@@ -24,6 +27,213 @@ class MemoryManager;
 template<typename Config = DefaultConfig>
 class DefaultAllocator;
 
+template<typename Config = DefaultConfig>
+class MemoryArena;
+
+// Header stored just below an aligned block: usable bytes and distance back to the base
+// The offset stays in the last four bytes so the block layout matches the classic scheme.
+struct MemoryAlignedHeader {
+    memory_uint64_t capacity;
+    memory_uint32_t reserved;
+    memory_uint32_t offset;
+
+    // Alignment actually applied, so the header itself is always naturally aligned
+    static constexpr memory_size_t effective_alignment(memory_size_t p_alignment) {
+        return p_alignment < alignof(MemoryAlignedHeader) ? alignof(MemoryAlignedHeader) : p_alignment;
+    }
+
+    // Base allocation size needed for p_bytes at p_alignment
+    static constexpr memory_size_t base_size(memory_size_t p_bytes, memory_size_t p_alignment) {
+        return p_bytes + effective_alignment(p_alignment) - 1 + sizeof(MemoryAlignedHeader);
+    }
+
+    // Base size for resizing a block that sits p_old_offset into its base: the base must still
+    // hold the kept bytes at their old offset until they are moved to the new alignment
+    static constexpr memory_size_t realloc_base_size(memory_size_t p_bytes, memory_size_t p_prev_bytes, memory_size_t p_alignment, memory_size_t p_old_offset) {
+        const memory_size_t kept = p_old_offset + (p_prev_bytes < p_bytes ? p_prev_bytes : p_bytes);
+        const memory_size_t needed = base_size(p_bytes, p_alignment);
+        return needed > kept ? needed : kept;
+    }
+
+    static MEMORY_ALWAYS_INLINE MemoryAlignedHeader* of(void* p_memory) {
+        return static_cast<MemoryAlignedHeader*>(p_memory) - 1;
+    }
+
+    // First aligned address in p_base that leaves room for the header
+    static MEMORY_ALWAYS_INLINE memory_uint8_t* place(void* p_base, memory_size_t p_alignment) {
+        const memory_size_t alignment = effective_alignment(p_alignment);
+        return reinterpret_cast<memory_uint8_t*>(
+            (reinterpret_cast<memory_uintptr_t>(p_base) + sizeof(MemoryAlignedHeader) + alignment - 1) & ~(alignment - 1));
+    }
+
+    // Write the header for p_memory inside a base block of p_base_usable bytes
+    static MEMORY_ALWAYS_INLINE void write(void* p_memory, void* p_base, memory_size_t p_base_usable) {
+        const memory_size_t offset = static_cast<memory_size_t>(static_cast<memory_uint8_t*>(p_memory) - static_cast<memory_uint8_t*>(p_base));
+        MemoryAlignedHeader* header = of(p_memory);
+        header->capacity = p_base_usable - offset;
+        header->offset = static_cast<memory_uint32_t>(offset);
+    }
+};
+
+// Process-wide enforcement of MemoryRuntimeConfig::max_memory_usage
+// Threads reserve the limit from a shared counter in chunks and spend it locally, so the
+// counter is only touched about once per RESERVE_CHUNK bytes. Each thread may hold up to two
+// chunks reserved but unused, and the limit should be set before anything is allocated.
+// Requests are checked before they are served; rounding to the real block size is charged after.
+class MemoryBudget {
+public:
+    static constexpr memory_int64_t RESERVE_CHUNK = 256 * 1024;
+
+private:
+    struct ThreadBudget {
+        memory_int64_t available;
+        bool registered;
+        bool finalized;
+    };
+
+    // Hands the thread's unused reservation back when it exits
+    struct ThreadBudgetReaper {
+        ~ThreadBudgetReaper() {
+            ThreadBudget& budget = thread_budget_;
+            budget.finalized = true;
+            trim(budget);
+        }
+    };
+
+    static std::atomic<memory_int64_t> reserved_;
+    static std::atomic<bool> warned_;
+    static thread_local ThreadBudget thread_budget_;
+
+    static void give_back(memory_int64_t p_bytes) {
+        const memory_int64_t reserved = reserved_.fetch_sub(p_bytes, std::memory_order_relaxed) - p_bytes;
+        const memory_size_t threshold = MemoryRuntimeConfig::instance().warning_threshold;
+        if (threshold != 0 && reserved < static_cast<memory_int64_t>(threshold)) {
+            warned_.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    // Hand the thread's budget back when it exits; every path that credits it registers first
+    static void register_thread(ThreadBudget& p_budget) {
+        if (!p_budget.registered && !p_budget.finalized) {
+            static thread_local ThreadBudgetReaper reaper;
+            (void)reaper;
+            p_budget.registered = true;
+        }
+    }
+
+    // Return everything above one spare chunk (all of it once the thread is exiting)
+    static void trim(ThreadBudget& p_budget) {
+        const memory_int64_t keep = p_budget.finalized ? 0 : RESERVE_CHUNK;
+        if (p_budget.available > keep) {
+            give_back(p_budget.available - keep);
+            p_budget.available = keep;
+        }
+    }
+
+    // Top the local budget up to p_bytes plus a spare chunk; p_force ignores the limit
+    static MEMORY_NO_INLINE bool reserve(ThreadBudget& p_budget, memory_int64_t p_bytes, bool p_force) {
+        register_thread(p_budget);
+
+        const memory_int64_t needed = p_bytes - p_budget.available;
+        memory_int64_t amount = needed + (p_budget.finalized ? 0 : RESERVE_CHUNK);
+        memory_int64_t reserved;
+        if (p_force) {
+            reserved = reserved_.fetch_add(amount, std::memory_order_relaxed) + amount;
+        }
+        else {
+            const memory_int64_t limit = static_cast<memory_int64_t>(MemoryRuntimeConfig::instance().max_memory_usage);
+            reserved = reserved_.load(std::memory_order_relaxed);
+            do {
+                if (reserved + amount > limit) {
+                    // Close to the limit: take only what this request needs
+                    if (reserved + needed > limit) {
+                        return false;
+                    }
+                    amount = needed;
+                }
+            } while (!reserved_.compare_exchange_weak(reserved, reserved + amount, std::memory_order_relaxed));
+            reserved += amount;
+        }
+        p_budget.available += amount;
+
+        const memory_size_t threshold = MemoryRuntimeConfig::instance().warning_threshold;
+        if (threshold != 0 && reserved >= static_cast<memory_int64_t>(threshold) &&
+            !warned_.exchange(true, std::memory_order_relaxed)) {
+            MEMORY_WARNING("Memory usage crossed warning_threshold");
+        }
+        return true;
+    }
+
+    static MEMORY_NO_INLINE bool acquire_slow(ThreadBudget& p_budget, memory_size_t p_bytes) {
+        const memory_int64_t bytes = static_cast<memory_int64_t>(p_bytes);
+        if (!reserve(p_budget, bytes, false)) {
+            // The hook may free memory (or raise the limit) and ask for one more attempt
+            const MemoryRuntimeConfig& config = MemoryRuntimeConfig::instance();
+            if (config.out_of_memory_hook == nullptr || !config.out_of_memory_hook(p_bytes, config.max_memory_usage) ||
+                !reserve(p_budget, bytes, false)) {
+                MEMORY_ERROR("Allocation exceeds max_memory_usage");
+                return false;
+            }
+        }
+        p_budget.available -= bytes;
+        return true;
+    }
+
+    // A thread that only frees never reserves, so its first release registers it
+    static MEMORY_NO_INLINE void release_slow(ThreadBudget& p_budget) {
+        register_thread(p_budget);
+        trim(p_budget);
+    }
+
+public:
+    // Take p_bytes from the budget; false (after the out-of-memory hook) when over the limit
+    static MEMORY_ALWAYS_INLINE bool acquire(memory_size_t p_bytes) {
+        ThreadBudget& budget = thread_budget_;
+        if (MEMORY_LIKELY(budget.available >= static_cast<memory_int64_t>(p_bytes))) {
+            budget.available -= static_cast<memory_int64_t>(p_bytes);
+            return true;
+        }
+        return acquire_slow(budget, p_bytes);
+    }
+
+    // Take p_bytes even past the limit (a block turned out larger than was acquired)
+    static MEMORY_ALWAYS_INLINE void charge(memory_size_t p_bytes) {
+        ThreadBudget& budget = thread_budget_;
+        budget.available -= static_cast<memory_int64_t>(p_bytes);
+        if (MEMORY_UNLIKELY(budget.available < 0)) {
+            reserve(budget, 0, true);
+        }
+    }
+
+    static MEMORY_ALWAYS_INLINE void release(memory_size_t p_bytes) {
+        ThreadBudget& budget = thread_budget_;
+        budget.available += static_cast<memory_int64_t>(p_bytes);
+        if (MEMORY_UNLIKELY(budget.available > 2 * RESERVE_CHUNK || !budget.registered || budget.finalized)) {
+            release_slow(budget);
+        }
+    }
+
+    // Correct an acquisition of p_acquired bytes to the p_actual bytes the block really occupies
+    static MEMORY_ALWAYS_INLINE void settle(memory_size_t p_acquired, memory_size_t p_actual) {
+        if (p_actual > p_acquired) {
+            charge(p_actual - p_acquired);
+        }
+        else if (p_actual < p_acquired) {
+            release(p_acquired - p_actual);
+        }
+    }
+
+    // Bytes reserved by all threads, including their unused chunks
+    static memory_uint64_t get_reserved() {
+        const memory_int64_t reserved = reserved_.load(std::memory_order_relaxed);
+        return reserved > 0 ? static_cast<memory_uint64_t>(reserved) : 0;
+    }
+};
+
+inline std::atomic<memory_int64_t> MemoryBudget::reserved_{ 0 };
+inline std::atomic<bool> MemoryBudget::warned_{ false };
+inline thread_local MemoryBudget::ThreadBudget MemoryBudget::thread_budget_{};
+
 // Core memory management implementation
 template<typename Config>
 class MemoryManager {
@@ -36,9 +246,237 @@ public:
     static constexpr memory_size_t DATA_OFFSET = Config::DATA_OFFSET;
 
 private:
+    using PoolType = MemoryPool<Config>;
+
+    static constexpr bool USE_POOL = Config::ALLOCATION_STRATEGY == MemoryAllocationStrategy::POOLED ||
+                                     Config::ALLOCATION_STRATEGY == MemoryAllocationStrategy::HYBRID;
+
+    // Backend dispatch: size-class pool or system allocator depending on the strategy
+    template<bool p_ensure_zero = false>
+    static MEMORY_ALWAYS_INLINE void* backend_alloc(memory_size_t p_bytes) {
+        if constexpr (USE_POOL) {
+            return PoolType::template alloc<p_ensure_zero>(p_bytes);
+        }
+        else if constexpr (p_ensure_zero) {
+            return std::calloc(1, p_bytes);
+        }
+        else {
+            return std::malloc(p_bytes);
+        }
+    }
+
+    static MEMORY_ALWAYS_INLINE void* backend_realloc(void* p_memory, memory_size_t p_bytes) {
+        if constexpr (USE_POOL) {
+            return PoolType::realloc(p_memory, p_bytes);
+        }
+        else {
+            return std::realloc(p_memory, p_bytes);
+        }
+    }
+
+    static MEMORY_ALWAYS_INLINE void backend_free(void* p_memory) {
+        if constexpr (USE_POOL) {
+            PoolType::free(p_memory);
+        }
+        else {
+            std::free(p_memory);
+        }
+    }
+
+    static memory_size_t backend_alloc_batch(memory_size_t p_bytes, memory_size_t p_count, void** r_ptrs) {
+        if constexpr (USE_POOL) {
+            return PoolType::alloc_batch(p_bytes, p_count, r_ptrs);
+        }
+        else {
+            for (memory_size_t i = 0; i < p_count; i++) {
+                if ((r_ptrs[i] = std::malloc(p_bytes)) == nullptr) {
+                    return i;
+                }
+            }
+            return p_count;
+        }
+    }
+
+    // Free an unpadded block and return the size the tracker accounted for it
+    // (p_bytes is the caller's size for sized frees, 0 when unknown)
+    static MEMORY_ALWAYS_INLINE memory_size_t backend_free_sized(void* p_memory, memory_size_t p_bytes) {
+        if constexpr (USE_POOL) {
+            return PoolType::free_sized(p_memory, p_bytes);
+        }
+        else {
+            const memory_size_t size = tracked_size(p_memory, p_bytes);
+            std::free(p_memory);
+            return size;
+        }
+    }
+
+    // Bytes usable in a backend block requested with p_bytes (pool blocks round up to their class or pages)
+    static MEMORY_ALWAYS_INLINE memory_size_t backend_usable_size(void* p_memory, memory_size_t p_bytes) {
+        if constexpr (USE_POOL) {
+            return PoolType::usable_size(p_memory);
+        }
+        else {
+            return p_bytes;
+        }
+    }
+
+    // Size reported to the tracker for an unpadded block, the same at allocation and free:
+    // pools know every block's real size from the page map, the system allocator reports
+    // its usable size where the platform can (else the request, and nothing at unsized frees)
+    static MEMORY_ALWAYS_INLINE memory_size_t tracked_size(void* p_memory, memory_size_t p_requested) {
+        if constexpr (!Config::ENABLE_TRACKING || Config::TRACKING_LEVEL == MemoryTrackingLevel::NONE) {
+            return p_requested;
+        }
+        else if constexpr (USE_POOL) {
+            return PoolType::usable_size(p_memory);
+        }
+        else {
+            const memory_size_t usable = memory_os_malloc_usable_size(p_memory);
+            return usable != 0 ? usable : p_requested;
+        }
+    }
+
+    // Bytes an unpadded backend block counts against max_memory_usage
+    // (0 where the system allocator cannot report it, leaving such blocks to the per-request check)
+    static MEMORY_ALWAYS_INLINE memory_size_t backend_block_size(void* p_memory) {
+        if constexpr (USE_POOL) {
+            return PoolType::usable_size(p_memory);
+        }
+        else {
+            return memory_os_malloc_usable_size(p_memory);
+        }
+    }
+
+    static MEMORY_ALWAYS_INLINE bool budget_enabled() {
+        return MemoryRuntimeConfig::instance().max_memory_usage != 0;
+    }
+
+    // Runtime hooks: compiled out unless Config::ENABLE_HOOKS, otherwise a single test of
+    // enable_hooks guards an out-of-line call. Hooks run after the operation completed.
+    static MEMORY_NO_INLINE void call_allocation_hook(void* p_ptr, memory_size_t p_size, const char* p_context) {
+        const MemoryRuntimeConfig::AllocationHook hook = MemoryRuntimeConfig::instance().allocation_hook;
+        if (hook) {
+            hook(p_ptr, p_size, p_context);
+        }
+    }
+
+    // Freed and reallocated blocks are passed by address, taken before the backend call,
+    // so the pointer itself is never used after it was freed
+    static MEMORY_NO_INLINE void call_deallocation_hook(memory_uintptr_t p_address, memory_size_t p_size, const char* p_context) {
+        const MemoryRuntimeConfig::DeallocationHook hook = MemoryRuntimeConfig::instance().deallocation_hook;
+        if (hook) {
+            hook(reinterpret_cast<void*>(p_address), p_size, p_context);
+        }
+    }
+
+    static MEMORY_NO_INLINE void call_realloc_hook(memory_uintptr_t p_old_address, void* p_new, memory_size_t p_old_size, memory_size_t p_new_size, const char* p_context) {
+        const MemoryRuntimeConfig::ReallocHook hook = MemoryRuntimeConfig::instance().realloc_hook;
+        if (hook) {
+            hook(reinterpret_cast<void*>(p_old_address), p_new, p_old_size, p_new_size, p_context);
+        }
+    }
+
+    static MEMORY_ALWAYS_INLINE bool hooks_enabled() {
+        if constexpr (Config::ENABLE_HOOKS) {
+            return MemoryRuntimeConfig::instance().enable_hooks;
+        }
+        else {
+            return false;
+        }
+    }
+
+    // Runtime instrumentation of a completed operation: heap sampling, then the hooks
+    static MEMORY_ALWAYS_INLINE void instrument_allocation(void* p_ptr, memory_size_t p_size, const char* p_context) {
+        if constexpr (Config::ENABLE_HOOKS) {
+            MemoryHeapSampler::on_allocation(p_ptr, p_size, p_context);
+            if (MEMORY_UNLIKELY(hooks_enabled())) {
+                call_allocation_hook(p_ptr, p_size, p_context);
+            }
+        }
+    }
+
+    // The sample is dropped before the block is freed, so the address cannot be reused meanwhile
+    static MEMORY_ALWAYS_INLINE void instrument_free(void* p_ptr) {
+        if constexpr (Config::ENABLE_HOOKS) {
+            MemoryHeapSampler::on_deallocation(p_ptr);
+        }
+    }
+
+    static MEMORY_ALWAYS_INLINE void instrument_deallocation(memory_uintptr_t p_address, memory_size_t p_size, const char* p_context) {
+        if (MEMORY_UNLIKELY(hooks_enabled())) {
+            call_deallocation_hook(p_address, p_size, p_context);
+        }
+    }
+
+    static MEMORY_ALWAYS_INLINE void instrument_reallocation(memory_uintptr_t p_old_address, void* p_new, memory_size_t p_old_size, memory_size_t p_new_size, const char* p_context) {
+        if constexpr (Config::ENABLE_HOOKS) {
+            if (p_new) {
+                MemoryHeapSampler::on_allocation(p_new, p_new_size, p_context);
+            }
+            if (MEMORY_UNLIKELY(hooks_enabled())) {
+                call_realloc_hook(p_old_address, p_new, p_old_size, p_new_size, p_context);
+            }
+        }
+    }
+
+    // Aligned blocks come natively aligned from the pool when it can, otherwise from an
+    // over-allocated base block with a MemoryAlignedHeader in front
+    static void* backend_alloc_aligned(memory_size_t p_bytes, memory_size_t p_alignment) {
+        if constexpr (USE_POOL) {
+            if (PoolType::can_align(p_bytes, p_alignment)) {
+                return PoolType::alloc_aligned(p_bytes, p_alignment);
+            }
+        }
+
+        const memory_size_t base_size = MemoryAlignedHeader::base_size(p_bytes, p_alignment);
+        void* p1 = backend_alloc(base_size);
+        if (p1 == nullptr) {
+            return nullptr;
+        }
+
+        memory_uint8_t* p2 = MemoryAlignedHeader::place(p1, p_alignment);
+        MemoryAlignedHeader::write(p2, p1, backend_usable_size(p1, base_size));
+        return p2;
+    }
+
+    // Usable bytes of an aligned block: its pool block or recorded capacity
+    static MEMORY_ALWAYS_INLINE memory_size_t aligned_block_size(void* p_memory) {
+        if constexpr (USE_POOL) {
+            if (PoolType::is_block_start(p_memory)) {
+                return PoolType::usable_size(p_memory);
+            }
+        }
+        return static_cast<memory_size_t>(MemoryAlignedHeader::of(p_memory)->capacity);
+    }
+
+    // Size reported to the tracker for an aligned block
+    static MEMORY_ALWAYS_INLINE memory_size_t tracked_aligned_size(void* p_memory) {
+        if constexpr (!Config::ENABLE_TRACKING || Config::TRACKING_LEVEL == MemoryTrackingLevel::NONE) {
+            return 0;
+        }
+        else {
+            return aligned_block_size(p_memory);
+        }
+    }
+
+    static void backend_free_aligned(void* p_memory) {
+        if constexpr (USE_POOL) {
+            if (PoolType::is_block_start(p_memory)) {
+                PoolType::free(p_memory);
+                return;
+            }
+        }
+        backend_free(static_cast<memory_uint8_t*>(p_memory) - MemoryAlignedHeader::of(p_memory)->offset);
+    }
+
     // Internal helper to check if we should use padding
     static constexpr bool should_use_padding(bool p_pad_align) {
-        if constexpr (Config::PADDING_POLICY == MemoryPaddingPolicy::NONE) {
+        if (p_pad_align) {
+            // Arrays keep their element count in the header whatever the policy
+            return true;
+        }
+        else if constexpr (Config::PADDING_POLICY == MemoryPaddingPolicy::NONE || USE_POOL) {
+            // The pool already knows every block's size
             return false;
         }
         else if constexpr (Config::PADDING_POLICY == MemoryPaddingPolicy::ALWAYS) {
@@ -48,7 +486,8 @@ private:
             return MEMORY_DEBUG_ENABLED;
         }
         else {
-            return p_pad_align;
+            // CONFIGURABLE pads only on request
+            return false;
         }
     }
 
@@ -67,16 +506,19 @@ public:
     template<bool p_ensure_zero = false>
     static void* alloc_static(memory_size_t p_bytes, bool p_pad_align = false) {
         const bool prepad = should_use_padding(p_pad_align);
-
-        void* mem;
-        if constexpr (p_ensure_zero) {
-            mem = std::calloc(1, p_bytes + (prepad ? DATA_OFFSET : 0));
-        }
-        else {
-            mem = std::malloc(p_bytes + (prepad ? DATA_OFFSET : 0));
+        const bool limited = budget_enabled();
+        if (limited && !MemoryBudget::acquire(p_bytes)) {
+            return nullptr;
         }
 
-        MEMORY_ERR_FAIL_NULL_V(mem, static_cast<void*>(nullptr));
+        void* mem = backend_alloc<p_ensure_zero>(p_bytes + (prepad ? DATA_OFFSET : 0));
+
+        if (MEMORY_UNLIKELY(mem == nullptr)) {
+            if (limited) {
+                MemoryBudget::release(p_bytes);
+            }
+            MEMORY_ERR_FAIL_NULL_V(mem, static_cast<void*>(nullptr));
+        }
 
         if (prepad) {
             memory_uint8_t* s8 = static_cast<memory_uint8_t*>(mem);
@@ -85,12 +527,25 @@ public:
 
             // Track allocation
             TrackerType::track_allocation(p_bytes, __FILE__, __LINE__, MEMORY_FUNCTION_STR);
+            TrackerType::track_request_size(p_bytes);
+            TrackerType::track_block(s8 + DATA_OFFSET, p_bytes);
+
+            instrument_allocation(s8 + DATA_OFFSET, p_bytes, MEMORY_FUNCTION_STR);
 
             return s8 + DATA_OFFSET;
         }
         else {
+            if (limited) {
+                MemoryBudget::settle(p_bytes, backend_block_size(mem));
+            }
+
             // Track allocation
-            TrackerType::track_allocation(p_bytes, __FILE__, __LINE__, MEMORY_FUNCTION_STR);
+            const memory_size_t size = tracked_size(mem, p_bytes);
+            TrackerType::track_allocation(size, __FILE__, __LINE__, MEMORY_FUNCTION_STR);
+            TrackerType::track_request_size(p_bytes);
+            TrackerType::track_block(mem, size);
+
+            instrument_allocation(mem, p_bytes, MEMORY_FUNCTION_STR);
 
             return mem;
         }
@@ -108,39 +563,96 @@ public:
         }
 
         memory_uint8_t* mem = static_cast<memory_uint8_t*>(p_memory);
+        const memory_uintptr_t address = reinterpret_cast<memory_uintptr_t>(p_memory);
         const bool prepad = should_use_padding(p_pad_align);
+        const bool limited = budget_enabled();
 
         if (prepad) {
             mem -= DATA_OFFSET;
             memory_uint64_t* s = get_size_ptr(mem);
             memory_size_t old_size = *s;
 
+            // Only growth needs budget up front; a shrink is given back once it succeeded
+            if (limited && p_bytes > old_size && !MemoryBudget::acquire(p_bytes - old_size)) {
+                return nullptr;
+            }
+
             // Track reallocation
             TrackerType::track_reallocation(old_size, p_bytes, __FILE__, __LINE__, MEMORY_FUNCTION_STR);
+            TrackerType::untrack_block(p_memory, true);
+
+            instrument_free(p_memory);
 
             if (p_bytes == 0) {
-                std::free(mem);
+                backend_free(mem);
+                if (limited) {
+                    MemoryBudget::release(old_size);
+                }
+                instrument_reallocation(address, nullptr, old_size, 0, MEMORY_FUNCTION_STR);
                 return nullptr;
             }
             else {
                 *s = p_bytes;
 
-                mem = static_cast<memory_uint8_t*>(std::realloc(mem, p_bytes + DATA_OFFSET));
-                MEMORY_ERR_FAIL_NULL_V(mem, static_cast<void*>(nullptr));
+                memory_uint8_t* new_mem = static_cast<memory_uint8_t*>(backend_realloc(mem, p_bytes + DATA_OFFSET));
+                if (MEMORY_UNLIKELY(new_mem == nullptr)) {
+                    *s = old_size;
+                    TrackerType::track_block(p_memory, old_size, true);
+                    if (limited && p_bytes > old_size) {
+                        MemoryBudget::release(p_bytes - old_size);
+                    }
+                    MEMORY_ERR_FAIL_NULL_V(new_mem, static_cast<void*>(nullptr));
+                }
+                mem = new_mem;
 
                 s = get_size_ptr(mem);
                 *s = p_bytes;
+                TrackerType::track_block(mem + DATA_OFFSET, p_bytes, true);
+
+                if (limited && p_bytes < old_size) {
+                    MemoryBudget::release(old_size - p_bytes);
+                }
+
+                instrument_reallocation(address, mem + DATA_OFFSET, old_size, p_bytes, MEMORY_FUNCTION_STR);
 
                 return mem + DATA_OFFSET;
             }
         }
         else {
-            // For non-padded allocations, we can't track the old size
-            // This is a limitation of the simple approach
-            TrackerType::track_reallocation(0, p_bytes, __FILE__, __LINE__, MEMORY_FUNCTION_STR);
+            const memory_size_t old_size = tracked_size(mem, 0);
+
+            // Growth past the current block is acquired up front and settled to the new block's size
+            const memory_size_t old_block = limited ? backend_block_size(mem) : 0;
+            const memory_size_t acquired = p_bytes > old_block ? p_bytes - old_block : 0;
+            if (limited && !MemoryBudget::acquire(acquired)) {
+                return nullptr;
+            }
+
+            const memory_size_t recorded_size = TrackerType::untrack_block(p_memory, true);
+            instrument_free(p_memory);
 
-            mem = static_cast<memory_uint8_t*>(std::realloc(mem, p_bytes));
-            MEMORY_ERR_FAIL_COND_V(mem == nullptr && p_bytes > 0, nullptr);
+            memory_uint8_t* new_mem = static_cast<memory_uint8_t*>(backend_realloc(mem, p_bytes));
+            if (MEMORY_UNLIKELY(new_mem == nullptr && p_bytes > 0)) {
+                TrackerType::track_block(p_memory, recorded_size, true);
+                if (limited) {
+                    MemoryBudget::release(acquired);
+                }
+                MEMORY_ERR_FAIL_COND_V(new_mem == nullptr && p_bytes > 0, nullptr);
+            }
+            mem = new_mem;
+
+            if (limited) {
+                MemoryBudget::settle(old_block + acquired, mem ? backend_block_size(mem) : 0);
+            }
+
+            // Track reallocation
+            const memory_size_t new_size = mem ? tracked_size(mem, p_bytes) : 0;
+            TrackerType::track_reallocation(old_size, new_size, __FILE__, __LINE__, MEMORY_FUNCTION_STR);
+            if (mem) {
+                TrackerType::track_block(mem, new_size, true);
+            }
+
+            instrument_reallocation(address, mem, old_size, p_bytes, MEMORY_FUNCTION_STR);
 
             return mem;
         }
@@ -149,8 +661,11 @@ public:
     // Free function
     static void free_static(void* p_ptr, bool p_pad_align = false) {
         MEMORY_ERR_FAIL_NULL(p_ptr);
+        TrackerType::untrack_block(p_ptr);
+        instrument_free(p_ptr);
 
         memory_uint8_t* mem = static_cast<memory_uint8_t*>(p_ptr);
+        const memory_uintptr_t address = reinterpret_cast<memory_uintptr_t>(p_ptr);
         const bool prepad = should_use_padding(p_pad_align);
 
         if (prepad) {
@@ -162,77 +677,328 @@ public:
             // Track deallocation
             TrackerType::track_deallocation(size, __FILE__, __LINE__, MEMORY_FUNCTION_STR);
 
-            std::free(mem);
+            backend_free(mem);
+            if (budget_enabled()) {
+                MemoryBudget::release(size);
+            }
+            instrument_deallocation(address, size, MEMORY_FUNCTION_STR);
         }
         else {
-            // For non-padded allocations, we can't track the size
-            TrackerType::track_deallocation(0, __FILE__, __LINE__, MEMORY_FUNCTION_STR);
+            if (budget_enabled()) {
+                MemoryBudget::release(backend_block_size(mem));
+            }
+
+            const memory_size_t size = backend_free_sized(mem, 0);
+
+            // Track deallocation
+            TrackerType::track_deallocation(size, __FILE__, __LINE__, MEMORY_FUNCTION_STR);
 
-            std::free(mem);
+            instrument_deallocation(address, size, MEMORY_FUNCTION_STR);
         }
     }
 
-    // Aligned allocation functions (preserving Godot's algorithm)
+    // Sized free: p_bytes must be the size passed at allocation, so no size header or lookup is
+    // needed to account for the block (pools still locate its span to pick the free list).
+    // Named apart from free_static, whose bool parameter would make integer sizes ambiguous.
+    static void free_sized_static(void* p_ptr, memory_size_t p_bytes, bool p_pad_align = false) {
+        MEMORY_ERR_FAIL_NULL(p_ptr);
+        TrackerType::untrack_block(p_ptr);
+        instrument_free(p_ptr);
+
+        memory_uint8_t* mem = static_cast<memory_uint8_t*>(p_ptr);
+        const memory_uintptr_t address = reinterpret_cast<memory_uintptr_t>(p_ptr);
+        const bool prepad = should_use_padding(p_pad_align);
+
+        if (prepad) {
+            mem -= DATA_OFFSET;
+            MEMORY_DEV_ASSERT(*get_size_ptr(mem) == p_bytes);
+
+            // Track deallocation
+            TrackerType::track_deallocation(p_bytes, __FILE__, __LINE__, MEMORY_FUNCTION_STR);
+
+            backend_free(mem);
+            if (budget_enabled()) {
+                MemoryBudget::release(p_bytes);
+            }
+            instrument_deallocation(address, p_bytes, MEMORY_FUNCTION_STR);
+        }
+        else {
+            if (budget_enabled()) {
+                MemoryBudget::release(backend_block_size(mem));
+            }
+
+            const memory_size_t size = backend_free_sized(mem, p_bytes);
+
+            // Track deallocation
+            TrackerType::track_deallocation(size, __FILE__, __LINE__, MEMORY_FUNCTION_STR);
+
+            instrument_deallocation(address, size, MEMORY_FUNCTION_STR);
+        }
+    }
+
+    // Allocate p_count blocks of p_bytes into r_ptrs with a single tracker update
+    // Returns how many blocks were allocated; stops at the first failure.
+    static memory_size_t alloc_batch(memory_size_t p_bytes, memory_size_t p_count, void** r_ptrs, bool p_pad_align = false) {
+        MEMORY_ERR_FAIL_NULL_V(r_ptrs, 0);
+
+        const bool prepad = should_use_padding(p_pad_align);
+        const bool limited = budget_enabled();
+        if (limited && !MemoryBudget::acquire(p_bytes * p_count)) {
+            return 0;
+        }
+
+        const memory_size_t count = backend_alloc_batch(p_bytes + (prepad ? DATA_OFFSET : 0), p_count, r_ptrs);
+        if (limited) {
+            MemoryBudget::settle(p_bytes * p_count, count == 0 ? 0 : (prepad ? p_bytes : backend_block_size(r_ptrs[0])) * count);
+        }
+        if (count == 0) {
+            MEMORY_ERR_FAIL_COND_V(p_count > 0, 0);
+            return 0;
+        }
+
+        // Pool blocks of one request size share a size class, so they share one tracked size;
+        // the system allocator's usable sizes are taken per block
+        memory_size_t size = p_bytes;
+        memory_size_t total = p_bytes * count;
+        if (prepad) {
+            for (memory_size_t i = 0; i < count; i++) {
+                memory_uint8_t* s8 = static_cast<memory_uint8_t*>(r_ptrs[i]);
+                *get_size_ptr(s8) = p_bytes;
+                r_ptrs[i] = s8 + DATA_OFFSET;
+            }
+        }
+        else if constexpr (USE_POOL) {
+            size = tracked_size(r_ptrs[0], p_bytes);
+            total = size * count;
+        }
+        else {
+            total = 0;
+            for (memory_size_t i = 0; i < count; i++) {
+                total += tracked_size(r_ptrs[i], p_bytes);
+            }
+        }
+
+        // Track allocation
+        TrackerType::track_allocation_batch(total, count, __FILE__, __LINE__, MEMORY_FUNCTION_STR);
+        TrackerType::track_request_size(p_bytes, count);
+        for (memory_size_t i = 0; i < count; i++) {
+            TrackerType::track_block(r_ptrs[i], prepad || USE_POOL ? size : tracked_size(r_ptrs[i], p_bytes));
+        }
+
+        if constexpr (Config::ENABLE_HOOKS) {
+            for (memory_size_t i = 0; i < count; i++) {
+                instrument_allocation(r_ptrs[i], p_bytes, MEMORY_FUNCTION_STR);
+            }
+        }
+
+        MEMORY_ERR_FAIL_COND_V(count < p_count, count);
+        return count;
+    }
+
+    // Free p_count blocks from alloc_static or alloc_batch with a single tracker update (null entries are skipped)
+    static void free_batch(void** p_ptrs, memory_size_t p_count, bool p_pad_align = false) {
+        MEMORY_ERR_FAIL_NULL(p_ptrs);
+
+        const bool prepad = should_use_padding(p_pad_align);
+        const bool limited = budget_enabled();
+        const bool hooked = hooks_enabled();
+        memory_size_t total = 0;
+        memory_size_t budget = 0;
+        memory_size_t freed = 0;
+        for (memory_size_t i = 0; i < p_count; i++) {
+            memory_uint8_t* mem = static_cast<memory_uint8_t*>(p_ptrs[i]);
+            if (mem == nullptr) {
+                continue;
+            }
+            const memory_uintptr_t address = reinterpret_cast<memory_uintptr_t>(mem);
+            TrackerType::untrack_block(mem);
+            instrument_free(mem);
+
+            memory_size_t size;
+            if (prepad) {
+                mem -= DATA_OFFSET;
+                size = *get_size_ptr(mem);
+                backend_free(mem);
+            }
+            else {
+                if (limited) {
+                    budget += backend_block_size(mem);
+                }
+                size = backend_free_sized(mem, 0);
+            }
+            total += size;
+            ++freed;
+
+            if (MEMORY_UNLIKELY(hooked)) {
+                call_deallocation_hook(address, size, MEMORY_FUNCTION_STR);
+            }
+        }
+
+        if (limited) {
+            MemoryBudget::release(prepad ? total : budget);
+        }
+
+        // Track deallocation
+        TrackerType::track_deallocation_batch(total, freed, __FILE__, __LINE__, MEMORY_FUNCTION_STR);
+    }
+
+    // Aligned allocation functions (pool-native where possible, else Godot's offset scheme plus the usable capacity)
     static void* alloc_aligned_static(memory_size_t p_bytes, memory_size_t p_alignment) {
         MEMORY_DEV_ASSERT(is_power_of_2(p_alignment));
 
-        void* p1;
-        void* p2;
-
-        if ((p1 = std::malloc(p_bytes + p_alignment - 1 + sizeof(memory_uint32_t))) == nullptr) {
+        const bool limited = budget_enabled();
+        if (limited && !MemoryBudget::acquire(p_bytes)) {
             return nullptr;
         }
 
-        p2 = reinterpret_cast<void*>(
-            (reinterpret_cast<memory_uintptr_t>(p1) + sizeof(memory_uint32_t) + p_alignment - 1) &
-            ~(p_alignment - 1)
-            );
-
-        *(static_cast<memory_uint32_t*>(p2) - 1) =
-            static_cast<memory_uint32_t>(
-                reinterpret_cast<memory_uintptr_t>(p2) - reinterpret_cast<memory_uintptr_t>(p1)
-                );
+        void* mem = backend_alloc_aligned(p_bytes, p_alignment);
+        if (limited) {
+            MemoryBudget::settle(p_bytes, mem ? aligned_block_size(mem) : 0);
+        }
+        if (mem == nullptr) {
+            return nullptr;
+        }
 
         // Track allocation
-        TrackerType::track_allocation(p_bytes, __FILE__, __LINE__, MEMORY_FUNCTION_STR);
+        TrackerType::track_allocation(tracked_aligned_size(mem), __FILE__, __LINE__, MEMORY_FUNCTION_STR);
+        TrackerType::track_request_size(p_bytes);
+        TrackerType::track_block(mem, tracked_aligned_size(mem));
 
-        return p2;
+        instrument_allocation(mem, p_bytes, MEMORY_FUNCTION_STR);
+
+        return mem;
     }
 
+    // Fits within the recorded capacity (including any shrink) without moving if already aligned
+    // to p_alignment; otherwise the base block is reallocated and the data only shifted if its
+    // alignment changed.
+    // On failure the original block is left intact.
     static void* realloc_aligned_static(void* p_memory, memory_size_t p_bytes, memory_size_t p_prev_bytes, memory_size_t p_alignment) {
         if (p_memory == nullptr) {
             return alloc_aligned_static(p_bytes, p_alignment);
         }
 
-        void* ret = alloc_aligned_static(p_bytes, p_alignment);
-        if (ret) {
-            std::memcpy(ret, p_memory, p_prev_bytes);
+        const memory_size_t old_size = tracked_aligned_size(p_memory);
+        const memory_uintptr_t address = reinterpret_cast<memory_uintptr_t>(p_memory);
+
+        // Growth past the current block is acquired up front and settled to the new block's size
+        const bool limited = budget_enabled();
+        const memory_size_t old_block = limited ? aligned_block_size(p_memory) : 0;
+        const memory_size_t acquired = p_bytes > old_block ? p_bytes - old_block : 0;
+        if (limited && !MemoryBudget::acquire(acquired)) {
+            return nullptr;
+        }
+
+        const memory_size_t recorded_size = TrackerType::untrack_block(p_memory, true);
+        instrument_free(p_memory);
+
+        if constexpr (USE_POOL) {
+            if (PoolType::is_block_start(p_memory)) {
+                void* ret = p_memory;
+                const bool aligned = (reinterpret_cast<memory_uintptr_t>(p_memory) & (p_alignment - 1)) == 0;
+                if (p_bytes > PoolType::usable_size(p_memory) || !aligned) {
+                    // Remapping only keeps page alignment, so stricter alignments move through a copy
+                    ret = aligned && p_alignment <= Config::PAGE_SIZE ? PoolType::grow_aligned(p_memory, p_bytes) : nullptr;
+                    if (ret == nullptr) {
+                        ret = backend_alloc_aligned(p_bytes, p_alignment);
+                        if (ret == nullptr) {
+                            if (limited) {
+                                MemoryBudget::release(acquired);
+                            }
+                            TrackerType::track_block(p_memory, recorded_size, true);
+                            return nullptr;
+                        }
+                        std::memcpy(ret, p_memory, p_prev_bytes < p_bytes ? p_prev_bytes : p_bytes);
+                        PoolType::free(p_memory);
+                    }
+                }
+
+                if (limited) {
+                    MemoryBudget::settle(old_block + acquired, aligned_block_size(ret));
+                }
+
+                // Track reallocation
+                TrackerType::track_reallocation(old_size, tracked_aligned_size(ret), __FILE__, __LINE__, MEMORY_FUNCTION_STR);
+                TrackerType::track_block(ret, tracked_aligned_size(ret), true);
+
+                instrument_reallocation(address, ret, p_prev_bytes, p_bytes, MEMORY_FUNCTION_STR);
+                return ret;
+            }
+        }
+
+        // A stricter alignment than the block already has always moves it
+        MemoryAlignedHeader* header = MemoryAlignedHeader::of(p_memory);
+        if (p_bytes <= header->capacity && (reinterpret_cast<memory_uintptr_t>(p_memory) & (p_alignment - 1)) == 0) {
+            // Track reallocation
+            TrackerType::track_reallocation(old_size, old_size, __FILE__, __LINE__, MEMORY_FUNCTION_STR);
+            TrackerType::track_block(p_memory, old_size, true);
+
+            instrument_reallocation(address, p_memory, p_prev_bytes, p_bytes, MEMORY_FUNCTION_STR);
+            return p_memory;
+        }
+
+        const memory_size_t old_offset = header->offset;
+        const memory_size_t base_size = MemoryAlignedHeader::realloc_base_size(p_bytes, p_prev_bytes, p_alignment, old_offset);
+        void* p1 = backend_realloc(static_cast<memory_uint8_t*>(p_memory) - old_offset, base_size);
+        if (p1 == nullptr) {
+            if (limited) {
+                MemoryBudget::release(acquired);
+            }
+            TrackerType::track_block(p_memory, recorded_size, true);
+            return nullptr;
+        }
+
+        memory_uint8_t* p2 = MemoryAlignedHeader::place(p1, p_alignment);
+        memory_uint8_t* moved = static_cast<memory_uint8_t*>(p1) + old_offset;
+        if (p2 != moved) {
+            std::memmove(p2, moved, p_prev_bytes < p_bytes ? p_prev_bytes : p_bytes);
+        }
+        MemoryAlignedHeader::write(p2, p1, backend_usable_size(p1, base_size));
+
+        if (limited) {
+            MemoryBudget::settle(old_block + acquired, aligned_block_size(p2));
         }
 
         // Track reallocation
-        TrackerType::track_reallocation(p_prev_bytes, p_bytes, __FILE__, __LINE__, MEMORY_FUNCTION_STR);
+        TrackerType::track_reallocation(old_size, tracked_aligned_size(p2), __FILE__, __LINE__, MEMORY_FUNCTION_STR);
+        TrackerType::track_block(p2, tracked_aligned_size(p2), true);
+
+        instrument_reallocation(address, p2, p_prev_bytes, p_bytes, MEMORY_FUNCTION_STR);
 
-        free_aligned_static(p_memory);
-        return ret;
+        return p2;
     }
 
     static void free_aligned_static(void* p_memory) {
         MEMORY_ERR_FAIL_NULL(p_memory);
 
-        memory_uint32_t offset = *(static_cast<memory_uint32_t*>(p_memory) - 1);
-        void* p = reinterpret_cast<void*>(
-            static_cast<memory_uint8_t*>(p_memory) - offset
-            );
+        const bool hooked = hooks_enabled();
+        const memory_size_t size = hooked ? aligned_block_size(p_memory) : 0;
+        const memory_uintptr_t address = reinterpret_cast<memory_uintptr_t>(p_memory);
 
-        // Track deallocation (we can't know the size)
-        TrackerType::track_deallocation(0, __FILE__, __LINE__, MEMORY_FUNCTION_STR);
+        if (budget_enabled()) {
+            MemoryBudget::release(aligned_block_size(p_memory));
+        }
 
-        std::free(p);
+        // Track deallocation
+        TrackerType::track_deallocation(tracked_aligned_size(p_memory), __FILE__, __LINE__, MEMORY_FUNCTION_STR);
+
+        TrackerType::untrack_block(p_memory);
+        instrument_free(p_memory);
+        backend_free_aligned(p_memory);
+
+        if (MEMORY_UNLIKELY(hooked)) {
+            call_deallocation_hook(address, size, MEMORY_FUNCTION_STR);
+        }
     }
 
     // Memory statistics
     static memory_uint64_t get_mem_available() {
-        return static_cast<memory_uint64_t>(-1); // 0xFFFF... (unlimited)
+        const memory_uint64_t limit = MemoryRuntimeConfig::instance().max_memory_usage;
+        if (limit == 0) {
+            return static_cast<memory_uint64_t>(-1); // 0xFFFF... (unlimited)
+        }
+        const memory_uint64_t reserved = MemoryBudget::get_reserved();
+        return reserved < limit ? limit - reserved : 0;
     }
 
     static memory_uint64_t get_mem_usage() {
@@ -247,6 +1013,11 @@ public:
         return TrackerType::get_stats();
     }
 
+    // Allocation counts by requested size (empty without tracking)
+    static MemorySizeHistogram get_size_histogram() {
+        return TrackerType::get_size_histogram();
+    }
+
     static void reset_memory_stats() {
         TrackerType::reset_stats();
     }
@@ -254,6 +1025,29 @@ public:
     static void dump_memory_allocations() {
         TrackerType::dump_allocations();
     }
+
+    // Return idle pooled pages to the OS now; returns the bytes released (0 without a pool)
+    static memory_size_t scavenge_memory() {
+        if constexpr (USE_POOL) {
+            return PoolType::scavenge(MemoryRuntimeConfig::instance().scavenge_decay_ms);
+        }
+        else {
+            return 0;
+        }
+    }
+
+    // Background scavenger for pooled, thread-safe configs (no-op otherwise)
+    static void start_scavenger() {
+        if constexpr (USE_POOL && Config::THREAD_POLICY != ThreadSafetyPolicy::NONE) {
+            PoolType::start_scavenger();
+        }
+    }
+
+    static void stop_scavenger() {
+        if constexpr (USE_POOL && Config::THREAD_POLICY != ThreadSafetyPolicy::NONE) {
+            PoolType::stop_scavenger();
+        }
+    }
 };
 
 // Default allocator implementation
@@ -270,11 +1064,194 @@ public:
         ManagerType::free_static(p_ptr, false);
     }
 
+    static MEMORY_FORCE_INLINE void free(void* p_ptr, memory_size_t p_memory) {
+        ManagerType::free_sized_static(p_ptr, p_memory, false);
+    }
+
     static MEMORY_FORCE_INLINE void* realloc(void* p_ptr, memory_size_t p_memory) {
         return ManagerType::realloc_static(p_ptr, p_memory, false);
     }
 };
 
+// Region allocator: bump-allocates from large chunks and frees everything at once
+// Objects placed in an arena are not destroyed by reset(); use memdelete_allocator
+// for types that need their destructor to run.
+template<typename Config>
+class MemoryArena {
+public:
+    using ManagerType = MemoryManager<Config>;
+
+    static constexpr memory_size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+private:
+    struct Chunk {
+        Chunk* prev;
+        memory_size_t size;
+    };
+
+    static constexpr memory_size_t CHUNK_HEADER_SIZE =
+        (sizeof(Chunk) + Config::DEFAULT_ALIGNMENT - 1) & ~(Config::DEFAULT_ALIGNMENT - 1);
+
+    Chunk* chunk_ = nullptr;
+    memory_uint8_t* ptr_ = nullptr;
+    memory_uint8_t* end_ = nullptr;
+    memory_size_t chunk_size_;
+
+    // Innermost arena scope active on this thread (target of the static allocator interface)
+    static thread_local MemoryArena* current_;
+
+    static MEMORY_ALWAYS_INLINE memory_uint8_t* chunk_begin(Chunk* p_chunk) {
+        return reinterpret_cast<memory_uint8_t*>(p_chunk) + CHUNK_HEADER_SIZE;
+    }
+
+    static MEMORY_ALWAYS_INLINE memory_uint8_t* chunk_end(Chunk* p_chunk) {
+        return reinterpret_cast<memory_uint8_t*>(p_chunk) + p_chunk->size;
+    }
+
+    MEMORY_NO_INLINE void* allocate_slow(memory_size_t p_bytes, memory_size_t p_alignment) {
+        const memory_size_t needed = CHUNK_HEADER_SIZE + p_bytes + p_alignment - 1;
+        const memory_size_t size = needed > chunk_size_ ? needed : chunk_size_;
+
+        Chunk* chunk = static_cast<Chunk*>(ManagerType::alloc_static(size));
+        MEMORY_ERR_FAIL_NULL_V(chunk, static_cast<void*>(nullptr));
+        chunk->prev = chunk_;
+        chunk->size = size;
+
+        chunk_ = chunk;
+        ptr_ = chunk_begin(chunk);
+        end_ = chunk_end(chunk);
+        return allocate(p_bytes, p_alignment);
+    }
+
+    // Free the chunks newer than p_keep; false if p_keep is no longer in the arena
+    // (released by reset()), in which case the first chunk is kept
+    bool release_chunks_until(Chunk* p_keep) {
+        while (chunk_ != p_keep) {
+            Chunk* prev = chunk_->prev;
+            if (prev == nullptr && p_keep != nullptr) {
+                return false;
+            }
+            ManagerType::free_static(chunk_);
+            chunk_ = prev;
+        }
+        return true;
+    }
+
+public:
+    // Position in the arena that rewind() can return to
+    struct Marker {
+        Chunk* chunk;
+        memory_uint8_t* ptr;
+    };
+
+    // Makes an arena the target of memnew_allocator for the current thread and
+    // rewinds it to where it was when the scope was opened
+    class Scope {
+    private:
+        MemoryArena& arena_;
+        MemoryArena* previous_;
+        Marker marker_;
+
+    public:
+        explicit Scope(MemoryArena& p_arena) : arena_(p_arena), previous_(current_), marker_(p_arena.mark()) {
+            current_ = &arena_;
+        }
+
+        ~Scope() {
+            arena_.rewind(marker_);
+            current_ = previous_;
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    explicit MemoryArena(memory_size_t p_chunk_size = DEFAULT_CHUNK_SIZE) : chunk_size_(p_chunk_size) {}
+
+    ~MemoryArena() {
+        release_chunks_until(nullptr);
+    }
+
+    MemoryArena(const MemoryArena&) = delete;
+    MemoryArena& operator=(const MemoryArena&) = delete;
+
+    MEMORY_FORCE_INLINE void* allocate(memory_size_t p_bytes, memory_size_t p_alignment = Config::DEFAULT_ALIGNMENT) {
+        MEMORY_DEV_ASSERT(is_power_of_2(p_alignment));
+
+        const memory_uintptr_t aligned =
+            (reinterpret_cast<memory_uintptr_t>(ptr_) + p_alignment - 1) & ~(p_alignment - 1);
+        if (MEMORY_LIKELY(ptr_ != nullptr && aligned + p_bytes <= reinterpret_cast<memory_uintptr_t>(end_))) {
+            ptr_ = reinterpret_cast<memory_uint8_t*>(aligned + p_bytes);
+            return reinterpret_cast<void*>(aligned);
+        }
+        return allocate_slow(p_bytes, p_alignment);
+    }
+
+    MEMORY_FORCE_INLINE Marker mark() const {
+        return Marker{ chunk_, ptr_ };
+    }
+
+    // Free everything allocated since p_marker was taken
+    // reset() should not be called inside an active Scope; if it released the marker's chunk,
+    // rewinding frees everything back to the start of the first chunk, as reset() does.
+    void rewind(const Marker& p_marker) {
+        const bool found = release_chunks_until(p_marker.chunk);
+        MEMORY_DEV_ASSERT(found);
+        if (MEMORY_UNLIKELY(!found)) {
+            ptr_ = chunk_begin(chunk_);
+            end_ = chunk_end(chunk_);
+        }
+        else if (chunk_) {
+            ptr_ = p_marker.ptr;
+            end_ = chunk_end(chunk_);
+        }
+        else {
+            ptr_ = nullptr;
+            end_ = nullptr;
+        }
+    }
+
+    // Free everything, keeping the first chunk for reuse (not inside an active Scope)
+    void reset() {
+        if (chunk_ == nullptr) {
+            return;
+        }
+        Chunk* first = chunk_;
+        while (first->prev) {
+            first = first->prev;
+        }
+        release_chunks_until(first);
+        ptr_ = chunk_begin(first);
+        end_ = chunk_end(first);
+    }
+
+    // Bytes reserved from the memory manager by this arena
+    memory_size_t get_reserved() const {
+        memory_size_t total = 0;
+        for (Chunk* chunk = chunk_; chunk; chunk = chunk->prev) {
+            total += chunk->size;
+        }
+        return total;
+    }
+
+    // Static allocator interface (memnew_allocator / memdelete_allocator) targeting the current scope
+    static MEMORY_FORCE_INLINE void* alloc(memory_size_t p_memory) {
+        MEMORY_ERR_FAIL_COND_V_MSG(current_ == nullptr, nullptr, "No MemoryArena::Scope is active on this thread.");
+        return current_->allocate(p_memory);
+    }
+
+    static MEMORY_FORCE_INLINE void free([[maybe_unused]] void* p_ptr) {
+        // Arena memory is reclaimed by reset() or when the scope closes
+    }
+
+    static MemoryArena* get_current() {
+        return current_;
+    }
+};
+
+template<typename Config>
+inline thread_local MemoryArena<Config>* MemoryArena<Config>::current_ = nullptr;
+
 // Convenience type aliases
 using Memory = MemoryManager<DefaultConfig>;
 using FastMemory = MemoryManager<HighPerformanceConfig>;
@@ -315,7 +1292,7 @@ inline void operator delete(void* p_mem, void* p_pointer, memory_size_t check, c
 template<>
 class MemoryManager<HighPerformanceConfig> {
 public:
-    // High-performance specialization with minimal overhead
+    // High-performance specialization with minimal overhead (max_memory_usage is not enforced)
     template<bool p_ensure_zero = false>
     static MEMORY_ALWAYS_INLINE void* alloc_static(memory_size_t p_bytes, [[maybe_unused]] bool p_pad_align = false) {
         void* mem;
@@ -340,24 +1317,34 @@ public:
         std::free(p_ptr);
     }
 
-    static MEMORY_ALWAYS_INLINE void* alloc_aligned_static(memory_size_t p_bytes, memory_size_t p_alignment) {
-        void* p1;
-        void* p2;
+    static MEMORY_ALWAYS_INLINE void free_sized_static(void* p_ptr, [[maybe_unused]] memory_size_t p_bytes, [[maybe_unused]] bool p_pad_align = false) {
+        std::free(p_ptr);
+    }
 
-        if ((p1 = std::malloc(p_bytes + p_alignment - 1 + sizeof(memory_uint32_t))) == nullptr) {
-            return nullptr;
+    static MEMORY_ALWAYS_INLINE memory_size_t alloc_batch(memory_size_t p_bytes, memory_size_t p_count, void** r_ptrs, [[maybe_unused]] bool p_pad_align = false) {
+        for (memory_size_t i = 0; i < p_count; i++) {
+            if ((r_ptrs[i] = std::malloc(p_bytes)) == nullptr) {
+                return i;
+            }
         }
+        return p_count;
+    }
 
-        p2 = reinterpret_cast<void*>(
-            (reinterpret_cast<memory_uintptr_t>(p1) + sizeof(memory_uint32_t) + p_alignment - 1) &
-            ~(p_alignment - 1)
-            );
+    static MEMORY_ALWAYS_INLINE void free_batch(void** p_ptrs, memory_size_t p_count, [[maybe_unused]] bool p_pad_align = false) {
+        for (memory_size_t i = 0; i < p_count; i++) {
+            std::free(p_ptrs[i]);
+        }
+    }
 
-        *(static_cast<memory_uint32_t*>(p2) - 1) =
-            static_cast<memory_uint32_t>(
-                reinterpret_cast<memory_uintptr_t>(p2) - reinterpret_cast<memory_uintptr_t>(p1)
-                );
+    static MEMORY_ALWAYS_INLINE void* alloc_aligned_static(memory_size_t p_bytes, memory_size_t p_alignment) {
+        const memory_size_t base_size = MemoryAlignedHeader::base_size(p_bytes, p_alignment);
+        void* p1 = std::malloc(base_size);
+        if (p1 == nullptr) {
+            return nullptr;
+        }
 
+        memory_uint8_t* p2 = MemoryAlignedHeader::place(p1, p_alignment);
+        MemoryAlignedHeader::write(p2, p1, base_size);
         return p2;
     }
 
@@ -366,17 +1353,30 @@ public:
             return alloc_aligned_static(p_bytes, p_alignment);
         }
 
-        void* ret = alloc_aligned_static(p_bytes, p_alignment);
-        if (ret) {
-            std::memcpy(ret, p_memory, p_prev_bytes);
+        // A stricter alignment than the block already has always moves it
+        MemoryAlignedHeader* header = MemoryAlignedHeader::of(p_memory);
+        if (p_bytes <= header->capacity && (reinterpret_cast<memory_uintptr_t>(p_memory) & (p_alignment - 1)) == 0) {
+            return p_memory;
+        }
+
+        const memory_size_t old_offset = header->offset;
+        const memory_size_t base_size = MemoryAlignedHeader::realloc_base_size(p_bytes, p_prev_bytes, p_alignment, old_offset);
+        void* p1 = std::realloc(static_cast<memory_uint8_t*>(p_memory) - old_offset, base_size);
+        if (p1 == nullptr) {
+            return nullptr;
+        }
+
+        memory_uint8_t* p2 = MemoryAlignedHeader::place(p1, p_alignment);
+        memory_uint8_t* moved = static_cast<memory_uint8_t*>(p1) + old_offset;
+        if (p2 != moved) {
+            std::memmove(p2, moved, p_prev_bytes < p_bytes ? p_prev_bytes : p_bytes);
         }
-        free_aligned_static(p_memory);
-        return ret;
+        MemoryAlignedHeader::write(p2, p1, base_size);
+        return p2;
     }
 
     static MEMORY_ALWAYS_INLINE void free_aligned_static(void* p_memory) {
-        memory_uint32_t offset = *(static_cast<memory_uint32_t*>(p_memory) - 1);
-        void* p = reinterpret_cast<void*>(static_cast<memory_uint8_t*>(p_memory) - offset);
+        void* p = static_cast<memory_uint8_t*>(p_memory) - MemoryAlignedHeader::of(p_memory)->offset;
         std::free(p);
     }
 
@@ -396,6 +1396,10 @@ public:
         return MemoryStats{};
     }
 
+    static MEMORY_ALWAYS_INLINE MemorySizeHistogram get_size_histogram() {
+        return MemorySizeHistogram{};
+    }
+
     static MEMORY_ALWAYS_INLINE void reset_memory_stats() {
         // No-op
     }
@@ -0,0 +1,318 @@
+/**************************************************************************/
+/*  memory_object_pool.h                                                 */
+/**************************************************************************/
+/*  Independent Memory Management Module                                  */
+/*  Typed object pools for hot memnew/memdelete types                    */
+/**************************************************************************/
+
+#pragma once
+
+#include "platform_defines.h"
+#include "error_handling.h"
+#include "thread_safe.h"
+#include "memory_config.h"
+#include "memory_manager.h"
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Pool of fixed-size slots laid out exactly for sizeof(T)/alignof(T)
+// Slots are carved from chunks obtained through MemoryManager<Config> and are
+// never returned to it; freed slots are recycled through per-thread free lists.
+template<typename T, typename Config = DefaultConfig>
+class ObjectPool {
+public:
+    using ManagerType = MemoryManager<Config>;
+    using LockType = SafeLock<Config::THREAD_POLICY>;
+
+    static constexpr memory_size_t SLOT_ALIGN = alignof(T) > alignof(void*) ? alignof(T) : alignof(void*);
+    static constexpr memory_size_t SLOT_SIZE =
+        ((sizeof(T) > sizeof(void*) ? sizeof(T) : sizeof(void*)) + SLOT_ALIGN - 1) & ~(SLOT_ALIGN - 1);
+    static constexpr memory_size_t SLOTS_PER_CHUNK = (64 * 1024) / SLOT_SIZE > 16 ? (64 * 1024) / SLOT_SIZE : 16;
+    static constexpr memory_size_t CHUNK_SIZE = SLOTS_PER_CHUNK * SLOT_SIZE;
+
+    // Slots moved between a thread cache and the shared list per transfer
+    static constexpr memory_uint32_t BATCH_SIZE = static_cast<memory_uint32_t>(
+        (16 * 1024) / SLOT_SIZE < 8 ? 8 : ((16 * 1024) / SLOT_SIZE > 128 ? 128 : (16 * 1024) / SLOT_SIZE));
+
+private:
+    struct Central {
+        LockType lock;
+        void* free_list = nullptr;
+        memory_uint8_t* chunk_ptr = nullptr;
+        memory_uint8_t* chunk_end = nullptr;
+    };
+
+    struct ThreadCache {
+        void* head;
+        memory_uint32_t length;
+        bool registered;
+        bool finalized;
+    };
+
+    struct ThreadCacheReaper {
+        ~ThreadCacheReaper() {
+            ThreadCache& cache = thread_cache_;
+            if (cache.length > 0) {
+                release_chain(cache.head, cache.length);
+                cache.head = nullptr;
+                cache.length = 0;
+            }
+            cache.finalized = true;
+        }
+    };
+
+    static constexpr bool USE_THREAD_CACHE = Config::THREAD_POLICY != ThreadSafetyPolicy::NONE;
+
+    static Central central_;
+    static thread_local ThreadCache thread_cache_;
+
+    // Pop one slot from the shared list or carve a new one (central lock held)
+    static void* take_slot() {
+        void* slot = central_.free_list;
+        if (slot) {
+            central_.free_list = *static_cast<void**>(slot);
+            return slot;
+        }
+
+        if (central_.chunk_ptr == central_.chunk_end) {
+            void* chunk;
+            if constexpr (SLOT_ALIGN > Config::DEFAULT_ALIGNMENT) {
+                chunk = ManagerType::alloc_aligned_static(CHUNK_SIZE, SLOT_ALIGN);
+            }
+            else {
+                chunk = ManagerType::alloc_static(CHUNK_SIZE);
+            }
+            MEMORY_ERR_FAIL_NULL_V(chunk, static_cast<void*>(nullptr));
+            central_.chunk_ptr = static_cast<memory_uint8_t*>(chunk);
+            central_.chunk_end = central_.chunk_ptr + CHUNK_SIZE;
+        }
+
+        slot = central_.chunk_ptr;
+        central_.chunk_ptr += SLOT_SIZE;
+        return slot;
+    }
+
+    // Splice a chain of p_count slots onto the shared list
+    static void release_chain(void* p_head, memory_uint32_t p_count) {
+        void* tail = p_head;
+        for (memory_uint32_t i = 1; i < p_count; i++) {
+            tail = *static_cast<void**>(tail);
+        }
+
+        std::lock_guard<LockType> guard(central_.lock);
+        *static_cast<void**>(tail) = central_.free_list;
+        central_.free_list = p_head;
+    }
+
+    // First cache use on this thread, by allocation or free: its slots go back at thread exit
+    static MEMORY_NO_INLINE void register_cache(ThreadCache& p_cache) {
+        static thread_local ThreadCacheReaper reaper;
+        (void)reaper;
+        p_cache.registered = true;
+    }
+
+    static MEMORY_NO_INLINE void* cache_refill(ThreadCache& p_cache) {
+        std::lock_guard<LockType> guard(central_.lock);
+        void* first = take_slot();
+        if (first == nullptr || p_cache.finalized) {
+            return first;
+        }
+        if (MEMORY_UNLIKELY(!p_cache.registered)) {
+            register_cache(p_cache);
+        }
+
+        for (memory_uint32_t i = 1; i < BATCH_SIZE; i++) {
+            void* slot = take_slot();
+            if (slot == nullptr) {
+                break;
+            }
+            *static_cast<void**>(slot) = p_cache.head;
+            p_cache.head = slot;
+            ++p_cache.length;
+        }
+        return first;
+    }
+
+    static MEMORY_NO_INLINE void cache_flush(ThreadCache& p_cache) {
+        // Keep the most recently freed batch local and hand the rest back
+        void* last_kept = p_cache.head;
+        for (memory_uint32_t i = 1; i < BATCH_SIZE; i++) {
+            last_kept = *static_cast<void**>(last_kept);
+        }
+        void* released = *static_cast<void**>(last_kept);
+        *static_cast<void**>(last_kept) = nullptr;
+
+        const memory_uint32_t count = p_cache.length - BATCH_SIZE;
+        p_cache.length = BATCH_SIZE;
+        release_chain(released, count);
+    }
+
+public:
+    // Uninitialised storage for one T
+    static MEMORY_FORCE_INLINE void* allocate() {
+        if constexpr (USE_THREAD_CACHE) {
+            ThreadCache& cache = thread_cache_;
+            void* slot = cache.head;
+            if (MEMORY_LIKELY(slot != nullptr)) {
+                cache.head = *static_cast<void**>(slot);
+                --cache.length;
+                return slot;
+            }
+            return cache_refill(cache);
+        }
+        else {
+            std::lock_guard<LockType> guard(central_.lock);
+            return take_slot();
+        }
+    }
+
+    static MEMORY_FORCE_INLINE void free(void* p_ptr) {
+        MEMORY_ERR_FAIL_NULL(p_ptr);
+
+        if constexpr (USE_THREAD_CACHE) {
+            ThreadCache& cache = thread_cache_;
+            if (MEMORY_UNLIKELY(cache.finalized)) {
+                release_chain(p_ptr, 1);
+                return;
+            }
+            if (MEMORY_UNLIKELY(!cache.registered)) {
+                register_cache(cache);
+            }
+            *static_cast<void**>(p_ptr) = cache.head;
+            cache.head = p_ptr;
+            if (MEMORY_UNLIKELY(++cache.length > 2 * BATCH_SIZE)) {
+                cache_flush(cache);
+            }
+        }
+        else {
+            std::lock_guard<LockType> guard(central_.lock);
+            *static_cast<void**>(p_ptr) = central_.free_list;
+            central_.free_list = p_ptr;
+        }
+    }
+
+    template<typename... Args>
+    static T* create(Args&&... p_args) {
+        void* mem = allocate();
+        MEMORY_ERR_FAIL_NULL_V(mem, static_cast<T*>(nullptr));
+        return ::new (mem) T(std::forward<Args>(p_args)...);
+    }
+
+    static void destroy(T* p_object) {
+        MEMORY_ERR_FAIL_NULL(p_object);
+        p_object->~T();
+        free(p_object);
+    }
+};
+
+// Static member definitions for ObjectPool
+template<typename T, typename Config>
+inline typename ObjectPool<T, Config>::Central ObjectPool<T, Config>::central_{};
+
+template<typename T, typename Config>
+inline thread_local typename ObjectPool<T, Config>::ThreadCache ObjectPool<T, Config>::thread_cache_{};
+
+// Detects types that opted into ObjectPool with MEMORY_OBJECT_POOLED
+// Types derived from a pooled class do not inherit the opt-in.
+template<typename T, typename = void>
+struct memory_uses_object_pool : std::false_type {};
+
+template<typename T>
+struct memory_uses_object_pool<T, std::void_t<typename T::memory_object_pool_type>>
+    : std::is_same<typename T::memory_object_pool_type, std::remove_cv_t<T>> {};
+
+template<typename T>
+inline constexpr bool memory_uses_object_pool_v = memory_uses_object_pool<T>::value;
+
+// Only types whose dynamic type is always T can be pooled: memdelete picks the pool from
+// the static type, so a pointer to a pooled base must never hold a derived object
+template<typename T>
+inline constexpr bool memory_can_object_pool_v = std::is_final_v<T> || !std::is_polymorphic_v<T>;
+
+// Allocator memnew uses for T, picked at compile time without class-scope lookup
+template<typename T>
+inline void* memory_new_allocate(memory_size_t p_size) {
+    if constexpr (memory_uses_object_pool_v<T>) {
+        static_assert(memory_can_object_pool_v<T>, "Pooled types must be final or non-polymorphic.");
+        return ObjectPool<std::remove_cv_t<T>>::allocate();
+    }
+    else {
+        return Memory::alloc_static(p_size, false);
+    }
+}
+
+template<typename T>
+inline void memory_new_free(void* p_ptr) {
+    if constexpr (memory_uses_object_pool_v<T>) {
+        ObjectPool<std::remove_cv_t<T>>::free(p_ptr);
+    }
+    else {
+        Memory::free_static(p_ptr, false);
+    }
+}
+
+// Placement tag memnew passes to ::new, carrying the allocator for the created type
+// (plain functions rather than templated placement forms, which GCC reports as mismatched)
+struct MemoryNewTag {
+    void* (*allocate)(memory_size_t p_size);
+    void (*free)(void* p_ptr);
+};
+
+template<typename T>
+constexpr MemoryNewTag memory_new_tag(T*) {
+    return MemoryNewTag{ &memory_new_allocate<T>, &memory_new_free<T> };
+}
+
+inline void* operator new(memory_size_t p_size, MemoryNewTag p_tag) {
+    return p_tag.allocate(p_size);
+}
+
+// Only called when the constructor throws
+inline void operator delete(void* p_ptr, MemoryNewTag p_tag) {
+    p_tag.free(p_ptr);
+}
+
+// Placement for the never-taken branch memnew uses to name the type it creates
+struct MemoryNewProbe {};
+
+inline void* operator new(memory_size_t, MemoryNewProbe) noexcept {
+    return nullptr;
+}
+
+inline void operator delete(void*, MemoryNewProbe) noexcept {}
+
+// Opt a class into ObjectPool<m_class>: place inside the class body.
+// memnew/memdelete (and plain new/delete) then use the pool, resolved at compile time.
+// The class must be final or non-polymorphic. Objects of derived classes fall back to
+// Memory because their size differs. The macro leaves public access in effect, so put
+// it first in the class body or follow it with an access specifier.
+#define MEMORY_OBJECT_POOLED(m_class)                                                   \
+public:                                                                                 \
+    using memory_object_pool_type = m_class;                                            \
+    static void* operator new(memory_size_t p_size) {                                   \
+        static_assert(memory_can_object_pool_v<m_class>,                                \
+                "Pooled types must be final or non-polymorphic.");                      \
+        if (p_size != sizeof(m_class)) {                                                \
+            return Memory::alloc_static(p_size, false);                                 \
+        }                                                                               \
+        return ObjectPool<m_class>::allocate();                                         \
+    }                                                                                   \
+    static void* operator new(memory_size_t p_size, const char*) {                      \
+        return operator new(p_size);                                                    \
+    }                                                                                   \
+    static void* operator new(memory_size_t, void* p_pointer) noexcept {                \
+        return p_pointer;                                                               \
+    }                                                                                   \
+    static void operator delete(void* p_ptr, memory_size_t p_size) {                    \
+        if (p_size != sizeof(m_class)) {                                                \
+            Memory::free_static(p_ptr, false);                                          \
+            return;                                                                     \
+        }                                                                               \
+        ObjectPool<m_class>::free(p_ptr);                                               \
+    }                                                                                   \
+    static void operator delete(void* p_ptr, const char*) {                             \
+        operator delete(p_ptr, sizeof(m_class));                                        \
+    }                                                                                   \
+    static void operator delete(void*, void*) noexcept {}
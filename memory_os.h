@@ -0,0 +1,231 @@
+/**************************************************************************/
+/*  memory_os.h                                                          */
+/**************************************************************************/
+/*  Independent Memory Management Module                                  */
+/*  Operating system page allocation                                     */
+/**************************************************************************/
+
+#pragma once
+
+#include "platform_defines.h"
+#include "error_handling.h"
+
+#if MEMORY_PLATFORM_WINDOWS
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#if MEMORY_PLATFORM_MACOS
+#include <malloc/malloc.h>
+#include <execinfo.h>
+#elif defined(__GLIBC__)
+#include <malloc.h>
+#include <execinfo.h>
+#include <sched.h>
+#endif
+#endif
+
+// glibc 2.35+ registers an rseq area per thread; the kernel keeps its cpu_id current
+#if defined(__GLIBC__) && defined(__GNUC__) && (defined(__x86_64__) || defined(__aarch64__)) && defined(__has_include)
+#if __has_include(<sys/rseq.h>)
+#include <sys/rseq.h>
+#define MEMORY_OS_HAS_RSEQ 1
+#endif
+#endif
+#ifndef MEMORY_OS_HAS_RSEQ
+#define MEMORY_OS_HAS_RSEQ 0
+#endif
+
+// Size of an OS page as reported by the system
+inline memory_size_t memory_os_page_size() {
+#if MEMORY_PLATFORM_WINDOWS
+    static const memory_size_t page_size = [] {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return static_cast<memory_size_t>(info.dwPageSize);
+    }();
+#else
+    static const memory_size_t page_size = static_cast<memory_size_t>(sysconf(_SC_PAGESIZE));
+#endif
+    return page_size;
+}
+
+// Map fresh, zero-filled, read/write pages (size must be a multiple of the page size)
+inline void* memory_os_alloc_pages(memory_size_t p_bytes) {
+#if MEMORY_PLATFORM_WINDOWS
+    return VirtualAlloc(nullptr, p_bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+    void* mem = mmap(nullptr, p_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return mem == MAP_FAILED ? nullptr : mem;
+#endif
+}
+
+// Whether memory_os_remap_pages can resize mappings on this platform
+#if MEMORY_PLATFORM_LINUX && defined(MREMAP_MAYMOVE) && defined(MREMAP_FIXED)
+#define MEMORY_OS_HAS_REMAP 1
+#else
+#define MEMORY_OS_HAS_REMAP 0
+#endif
+
+// Resize a mapping without copying its contents: in place, or moved onto p_target, which
+// must be a mapping of p_new_bytes owned by the caller (it is replaced, never another's)
+// Returns the new address, or nullptr when that is not possible; the old mapping is then untouched.
+inline void* memory_os_remap_pages([[maybe_unused]] void* p_memory, [[maybe_unused]] memory_size_t p_old_bytes,
+        [[maybe_unused]] memory_size_t p_new_bytes, [[maybe_unused]] void* p_target = nullptr) {
+#if MEMORY_OS_HAS_REMAP
+    void* mem = p_target
+        ? mremap(p_memory, p_old_bytes, p_new_bytes, MREMAP_MAYMOVE | MREMAP_FIXED, p_target)
+        : mremap(p_memory, p_old_bytes, p_new_bytes, 0);
+    return mem == MAP_FAILED ? nullptr : mem;
+#else
+    return nullptr;
+#endif
+}
+
+// Drop the physical backing of idle pages while keeping the range mapped and usable
+// Linux refaults released pages as zeros; elsewhere their contents are undefined.
+inline void memory_os_release_pages(void* p_memory, memory_size_t p_bytes) {
+    MEMORY_ERR_FAIL_NULL(p_memory);
+#if MEMORY_PLATFORM_WINDOWS
+    VirtualAlloc(p_memory, p_bytes, MEM_RESET, PAGE_READWRITE);
+#elif MEMORY_PLATFORM_LINUX || !defined(MADV_FREE)
+    madvise(p_memory, p_bytes, MADV_DONTNEED);
+#else
+    madvise(p_memory, p_bytes, MADV_FREE);
+#endif
+}
+
+// Unmap pages previously returned by memory_os_alloc_pages
+inline void memory_os_free_pages(void* p_memory, [[maybe_unused]] memory_size_t p_bytes) {
+    MEMORY_ERR_FAIL_NULL(p_memory);
+#if MEMORY_PLATFORM_WINDOWS
+    VirtualFree(p_memory, 0, MEM_RELEASE);
+#else
+    munmap(p_memory, p_bytes);
+#endif
+}
+
+// Usable size of a block from the system malloc, or 0 where the C library cannot tell
+inline memory_size_t memory_os_malloc_usable_size([[maybe_unused]] void* p_memory) {
+#if MEMORY_PLATFORM_WINDOWS
+    return _msize(p_memory);
+#elif MEMORY_PLATFORM_MACOS
+    return malloc_size(p_memory);
+#elif defined(__GLIBC__)
+    return malloc_usable_size(p_memory);
+#else
+    return 0;
+#endif
+}
+
+// CPU the calling thread is running on, or -1 where the platform cannot tell
+// Only a hint: the thread may migrate right after. Reads the rseq area when glibc has
+// registered one (a plain TLS load) and falls back to sched_getcpu().
+inline int memory_os_current_cpu() {
+#if MEMORY_PLATFORM_WINDOWS
+    return static_cast<int>(GetCurrentProcessorNumber());
+#elif MEMORY_OS_HAS_RSEQ
+    if (MEMORY_LIKELY(__rseq_size > 0)) {
+        const struct rseq* area = reinterpret_cast<const struct rseq*>(
+            static_cast<char*>(__builtin_thread_pointer()) + __rseq_offset);
+        const int cpu = static_cast<int>(__atomic_load_n(&area->cpu_id, __ATOMIC_RELAXED));
+        if (MEMORY_LIKELY(cpu >= 0)) {
+            return cpu;
+        }
+    }
+    return sched_getcpu();
+#elif defined(__GLIBC__)
+    return sched_getcpu();
+#else
+    return -1;
+#endif
+}
+
+// Return addresses of the calling thread's stack, skipping p_skip frames above the caller
+// Returns the number of frames written (0 where the platform cannot unwind).
+MEMORY_NO_INLINE inline int memory_os_capture_stack(void** r_frames, int p_max_depth, int p_skip) {
+#if MEMORY_PLATFORM_WINDOWS
+    return static_cast<int>(CaptureStackBackTrace(static_cast<DWORD>(p_skip + 1), static_cast<DWORD>(p_max_depth), r_frames, nullptr));
+#elif MEMORY_PLATFORM_MACOS || defined(__GLIBC__)
+    void* frames[128];
+    const int wanted = p_max_depth + p_skip + 1 < 128 ? p_max_depth + p_skip + 1 : 128;
+    const int captured = backtrace(frames, wanted);
+    int depth = 0;
+    for (int i = p_skip + 1; i < captured && depth < p_max_depth; i++) {
+        r_frames[depth++] = frames[i];
+    }
+    return depth;
+#else
+    (void)r_frames;
+    (void)p_max_depth;
+    (void)p_skip;
+    return 0;
+#endif
+}
+
+// Fast stack capture by following the frame-pointer chain, bounded to the thread's stack
+// Frames compiled without frame pointers are skipped over or end the walk early, so build
+// with -fno-omit-frame-pointer for complete stacks. Falls back to memory_os_capture_stack
+// where the chain cannot be walked safely or ends right away.
+MEMORY_NO_INLINE inline int memory_os_walk_frames(void** r_frames, int p_max_depth, int p_skip) {
+#if (MEMORY_PLATFORM_LINUX && defined(__GLIBC__) || MEMORY_PLATFORM_MACOS) && (defined(__x86_64__) || defined(__aarch64__))
+    // Bounds of the calling thread's stack, looked up once per thread
+    static thread_local memory_uintptr_t stack_low = 0;
+    static thread_local memory_uintptr_t stack_high = 0;
+    if (MEMORY_UNLIKELY(stack_high == 0)) {
+#if MEMORY_PLATFORM_MACOS
+        stack_high = reinterpret_cast<memory_uintptr_t>(pthread_get_stackaddr_np(pthread_self()));
+        stack_low = stack_high - pthread_get_stacksize_np(pthread_self());
+#else
+        pthread_attr_t attr;
+        void* address = nullptr;
+        size_t size = 0;
+        if (pthread_getattr_np(pthread_self(), &attr) == 0) {
+            pthread_attr_getstack(&attr, &address, &size);
+            pthread_attr_destroy(&attr);
+        }
+        stack_low = reinterpret_cast<memory_uintptr_t>(address);
+        stack_high = stack_low + size;
+#endif
+        if (stack_high == stack_low) {
+            return memory_os_capture_stack(r_frames, p_max_depth, p_skip);
+        }
+    }
+
+    // Each frame record holds the caller's frame pointer followed by the return address
+    memory_uintptr_t frame = reinterpret_cast<memory_uintptr_t>(__builtin_frame_address(0));
+    int depth = 0;
+    int skip = p_skip;
+    while (depth < p_max_depth && frame >= stack_low && frame + 2 * sizeof(void*) <= stack_high &&
+           (frame & (sizeof(void*) - 1)) == 0) {
+        const memory_uintptr_t* record = reinterpret_cast<const memory_uintptr_t*>(frame);
+        const memory_uintptr_t next = record[0];
+        void* return_address = reinterpret_cast<void*>(record[1]);
+        if (return_address == nullptr) {
+            break;
+        }
+        if (skip > 0) {
+            --skip;
+        }
+        else {
+            r_frames[depth++] = return_address;
+        }
+        // Stacks grow down: the caller's frame must be above this one
+        if (next <= frame) {
+            break;
+        }
+        frame = next;
+    }
+    if (depth < 2 && depth < p_max_depth) {
+        // The caller was built without frame pointers: take the slow unwinder instead
+        return memory_os_capture_stack(r_frames, p_max_depth, p_skip + 1);
+    }
+    return depth;
+#else
+    return memory_os_capture_stack(r_frames, p_max_depth, p_skip);
+#endif
+}
@@ -0,0 +1,1342 @@
+/**************************************************************************/
+/*  memory_pool.h                                                        */
+/**************************************************************************/
+/*  Independent Memory Management Module                                  */
+/*  Size-class slab allocator used by pooled allocation strategies       */
+/**************************************************************************/
+
+#pragma once
+
+#include "platform_defines.h"
+#include "error_handling.h"
+#include "thread_safe.h"
+#include "memory_config.h"
+#include "memory_os.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <thread>
+
+// Segregated size classes for small allocations
+// 16..128 bytes in steps of 16, then four classes per power of two up to MAX_SIZE
+struct MemorySizeClasses {
+    static constexpr memory_size_t MIN_SIZE = 16;
+    static constexpr memory_size_t MAX_SIZE = 8192;
+    static constexpr memory_uint32_t LINEAR_COUNT = 8;
+    static constexpr memory_uint32_t STEPS_PER_DOUBLING = 4;
+    static constexpr memory_uint32_t COUNT = 32;
+
+    // Every small span (slab) covers the same number of bytes
+    static constexpr memory_size_t SPAN_BYTES = 64 * 1024;
+
+    static constexpr memory_size_t size_of(memory_uint32_t p_index) {
+        if (p_index < LINEAR_COUNT) {
+            return (p_index + 1) * MIN_SIZE;
+        }
+        const memory_uint32_t group = (p_index - LINEAR_COUNT) / STEPS_PER_DOUBLING;
+        const memory_uint32_t step = (p_index - LINEAR_COUNT) % STEPS_PER_DOUBLING;
+        const memory_size_t base = (LINEAR_COUNT * MIN_SIZE) << group;
+        return base + (step + 1) * (base / STEPS_PER_DOUBLING);
+    }
+
+    // Size class for p_bytes (p_bytes must not exceed MAX_SIZE)
+    static MEMORY_ALWAYS_INLINE memory_uint32_t index_of(memory_size_t p_bytes) {
+        if (p_bytes <= LINEAR_COUNT * MIN_SIZE) {
+            return p_bytes == 0 ? 0 : static_cast<memory_uint32_t>((p_bytes - 1) / MIN_SIZE);
+        }
+        const memory_uint64_t last = p_bytes - 1;
+        const memory_uint32_t lg = log2_floor(last);
+        return LINEAR_COUNT + (lg - LINEAR_LOG2) * STEPS_PER_DOUBLING +
+               static_cast<memory_uint32_t>(last >> (lg - STEPS_LOG2)) - STEPS_PER_DOUBLING;
+    }
+
+private:
+    static constexpr memory_uint32_t LINEAR_LOG2 = 7;  // log2(LINEAR_COUNT * MIN_SIZE)
+    static constexpr memory_uint32_t STEPS_LOG2 = 2;   // log2(STEPS_PER_DOUBLING)
+
+    static_assert(LINEAR_COUNT * MIN_SIZE == (memory_size_t(1) << LINEAR_LOG2), "Invalid linear class range");
+    static_assert(STEPS_PER_DOUBLING == (1u << STEPS_LOG2), "Invalid class steps");
+};
+
+static_assert(MemorySizeClasses::size_of(MemorySizeClasses::COUNT - 1) == MemorySizeClasses::MAX_SIZE, "Size class table does not end at MAX_SIZE");
+
+// What a span of pages is used for
+enum class MemorySpanKind : memory_uint8_t {
+    FREE,       // Unused run held by the page heap
+    SMALL,      // Slab carved into blocks of one size class
+    RUN,        // Medium allocation occupying whole pages
+    LARGE       // Large allocation mapped directly from the OS
+};
+
+// Descriptor for a contiguous run of pages owned by a pool
+struct MemorySpan {
+    memory_uint8_t* start = nullptr;
+    memory_size_t page_count = 0;
+    MemorySpanKind kind = MemorySpanKind::SMALL;
+    memory_uint32_t size_class = 0;
+    memory_size_t block_size = 0;
+
+    // Free run state: when the run became free and whether its pages were given back to the OS
+    memory_uint64_t free_since = 0;
+    bool released = false;
+
+    // Small span state
+    memory_uint32_t capacity = 0;
+    memory_uint32_t used = 0;
+    void* free_list = nullptr;
+    memory_uint8_t* bump = nullptr;
+
+    // Thread cache that allocates from the span (small spans in thread-safe pools)
+    // Changed under the class lock but read by frees on any thread, hence atomic.
+    std::atomic<void*> owner{ nullptr };
+
+    // Intrusive list links
+    MemorySpan* next = nullptr;
+    MemorySpan* prev = nullptr;
+};
+
+// Fixed-size node allocator for pool metadata (not thread-safe, never returns memory to the OS)
+template<typename T>
+class MemoryMetadataAllocator {
+private:
+    static constexpr memory_size_t CHUNK_BYTES = 64 * 1024;
+    static constexpr memory_size_t NODE_SIZE = sizeof(T) > sizeof(void*) ? sizeof(T) : sizeof(void*);
+
+    void* free_list_ = nullptr;
+    memory_uint8_t* chunk_ = nullptr;
+    memory_uint8_t* chunk_end_ = nullptr;
+
+public:
+    constexpr MemoryMetadataAllocator() = default;
+
+    T* create() {
+        void* mem = free_list_;
+        if (mem) {
+            free_list_ = *static_cast<void**>(mem);
+        }
+        else {
+            if (chunk_ == nullptr || chunk_ + NODE_SIZE > chunk_end_) {
+                chunk_ = static_cast<memory_uint8_t*>(memory_os_alloc_pages(CHUNK_BYTES));
+                MEMORY_ERR_FAIL_NULL_V(chunk_, static_cast<T*>(nullptr));
+                chunk_end_ = chunk_ + CHUNK_BYTES;
+            }
+            mem = chunk_;
+            chunk_ += NODE_SIZE;
+        }
+        return ::new (mem) T();
+    }
+
+    void destroy(T* p_node) {
+        MEMORY_ERR_FAIL_NULL(p_node);
+        p_node->~T();
+        *reinterpret_cast<void**>(p_node) = free_list_;
+        free_list_ = p_node;
+    }
+};
+
+// Radix tree mapping page numbers to the span that owns them
+// Lookups are lock-free; updates must be serialised by the caller
+template<memory_uint32_t PageShift>
+class MemoryPageMap {
+private:
+    static constexpr memory_uint32_t ADDRESS_BITS = sizeof(void*) == 8 ? 48 : 32;
+    static constexpr memory_uint32_t KEY_BITS = ADDRESS_BITS - PageShift;
+    static constexpr memory_uint32_t INTERIOR_BITS = (KEY_BITS + 2) / 3;
+    static constexpr memory_uint32_t LEAF_BITS = KEY_BITS - 2 * INTERIOR_BITS;
+    static constexpr memory_size_t INTERIOR_LENGTH = memory_size_t(1) << INTERIOR_BITS;
+    static constexpr memory_size_t LEAF_LENGTH = memory_size_t(1) << LEAF_BITS;
+
+    struct Leaf {
+        std::atomic<MemorySpan*> spans[LEAF_LENGTH];
+    };
+
+    struct Node {
+        std::atomic<Leaf*> leaves[INTERIOR_LENGTH];
+    };
+
+    std::atomic<Node*> root_[INTERIOR_LENGTH];
+
+    static MEMORY_ALWAYS_INLINE memory_uintptr_t key_of(const void* p_address) {
+        return reinterpret_cast<memory_uintptr_t>(p_address) >> PageShift;
+    }
+
+    Leaf* ensure_leaf(memory_uintptr_t p_key) {
+        std::atomic<Node*>& node_slot = root_[p_key >> (LEAF_BITS + INTERIOR_BITS)];
+        Node* node = node_slot.load(std::memory_order_acquire);
+        if (node == nullptr) {
+            node = static_cast<Node*>(memory_os_alloc_pages(sizeof(Node)));
+            MEMORY_ERR_FAIL_NULL_V(node, static_cast<Leaf*>(nullptr));
+            node_slot.store(node, std::memory_order_release);
+        }
+
+        std::atomic<Leaf*>& leaf_slot = node->leaves[(p_key >> LEAF_BITS) & (INTERIOR_LENGTH - 1)];
+        Leaf* leaf = leaf_slot.load(std::memory_order_acquire);
+        if (leaf == nullptr) {
+            leaf = static_cast<Leaf*>(memory_os_alloc_pages(sizeof(Leaf)));
+            MEMORY_ERR_FAIL_NULL_V(leaf, static_cast<Leaf*>(nullptr));
+            leaf_slot.store(leaf, std::memory_order_release);
+        }
+        return leaf;
+    }
+
+public:
+    // Span owning the page that contains p_address, or nullptr if the page is not ours
+    MEMORY_ALWAYS_INLINE MemorySpan* get(const void* p_address) const {
+        const memory_uintptr_t key = key_of(p_address);
+        if (MEMORY_UNLIKELY(key >> KEY_BITS)) {
+            return nullptr;
+        }
+
+        const Node* node = root_[key >> (LEAF_BITS + INTERIOR_BITS)].load(std::memory_order_acquire);
+        if (node == nullptr) {
+            return nullptr;
+        }
+        const Leaf* leaf = node->leaves[(key >> LEAF_BITS) & (INTERIOR_LENGTH - 1)].load(std::memory_order_acquire);
+        if (leaf == nullptr) {
+            return nullptr;
+        }
+        return leaf->spans[key & (LEAF_LENGTH - 1)].load(std::memory_order_acquire);
+    }
+
+    // Map p_pages pages starting at p_start to p_span (nullptr clears the range)
+    bool set_range(const void* p_start, memory_size_t p_pages, MemorySpan* p_span) {
+        const memory_uintptr_t first = key_of(p_start);
+        MEMORY_ERR_FAIL_COND_V((first + p_pages - 1) >> KEY_BITS, false);
+
+        for (memory_size_t i = 0; i < p_pages; i++) {
+            const memory_uintptr_t key = first + i;
+            Leaf* leaf = ensure_leaf(key);
+            if (leaf == nullptr) {
+                return false;
+            }
+            leaf->spans[key & (LEAF_LENGTH - 1)].store(p_span, std::memory_order_release);
+        }
+        return true;
+    }
+};
+
+// Size-class slab pool backing MemoryAllocationStrategy::POOLED and HYBRID
+// Requests up to the small threshold are served from per-class slabs with no
+// per-block header; the page map recovers any block's span and size. POOLED
+// sends anything larger to the system allocator behind a size word; HYBRID
+// gives medium requests a run of pages and maps large ones directly.
+// Thread-safe configs put a per-thread cache in front of the shared classes
+// and move blocks to and from it in batches, parking full batches on a
+// lock-free stack before falling back to the locked span lists. Each cache
+// refills from small spans it owns; blocks freed on another thread are pushed
+// onto the owner's remote-free queue and drained on its next refill.
+template<typename Config>
+class MemoryPool {
+public:
+    using LockType = SafeLock<Config::THREAD_POLICY>;
+
+    static constexpr memory_uint32_t page_shift() {
+        memory_uint32_t shift = 0;
+        while ((memory_size_t(1) << shift) < Config::PAGE_SIZE) {
+            ++shift;
+        }
+        return shift;
+    }
+
+    static constexpr memory_uint32_t PAGE_SHIFT = page_shift();
+    static constexpr memory_size_t SPAN_PAGES = MemorySizeClasses::SPAN_BYTES >> PAGE_SHIFT;
+
+    static_assert((memory_size_t(1) << PAGE_SHIFT) == Config::PAGE_SIZE, "PAGE_SIZE must be a power of 2");
+    static_assert(MemorySizeClasses::SPAN_BYTES % Config::PAGE_SIZE == 0, "Span size must be a multiple of PAGE_SIZE");
+
+private:
+    struct CacheOwner;
+
+    struct SizeClass {
+        LockType lock;
+        MemorySpan* spans = nullptr; // Unowned spans with at least one free block
+
+        // Full thread-cache batches, linked through the second word of each batch head
+        SafeStack<Config::THREAD_POLICY, 1> batches;
+        SafeNumeric<memory_uint32_t, memory_scalar_policy(Config::THREAD_POLICY), AtomicOrderPolicy::RELAXED> batch_count; // Soft cap only
+    };
+
+    // Batches parked per class before flushes fall back to the spans
+    static constexpr memory_uint32_t MAX_CENTRAL_BATCHES = 16;
+
+    // Exact-size free run buckets; the last bucket holds every longer run
+    static constexpr memory_size_t HEAP_BUCKETS = 256;
+    static constexpr memory_size_t HEAP_GROW_PAGES = (1024 * 1024) >> PAGE_SHIFT;
+
+    static_assert(HEAP_BUCKETS % 64 == 0, "Run bucket bitmap must fill whole words");
+
+    static SizeClass classes_[MemorySizeClasses::COUNT];
+    static LockType heap_lock_;
+    static MemorySpan* free_runs_[HEAP_BUCKETS + 1];
+    static memory_uint64_t free_run_bits_[HEAP_BUCKETS / 64];
+    static MemoryMetadataAllocator<MemorySpan> span_allocator_;
+    static MemoryPageMap<PAGE_SHIFT> page_map_;
+
+    static MEMORY_ALWAYS_INLINE void link_span(MemorySpan*& p_list, MemorySpan* p_span) {
+        p_span->prev = nullptr;
+        p_span->next = p_list;
+        if (p_list) {
+            p_list->prev = p_span;
+        }
+        p_list = p_span;
+    }
+
+    static MEMORY_ALWAYS_INLINE void unlink_span(MemorySpan*& p_list, MemorySpan* p_span) {
+        if (p_span->prev) {
+            p_span->prev->next = p_span->next;
+        }
+        else {
+            p_list = p_span->next;
+        }
+        if (p_span->next) {
+            p_span->next->prev = p_span->prev;
+        }
+        p_span->next = nullptr;
+        p_span->prev = nullptr;
+    }
+
+    // Page heap: runs of PAGE_SIZE pages carved from large OS chunks (heap lock held)
+    static MEMORY_ALWAYS_INLINE void set_run_bit(memory_size_t p_pages, bool p_set) {
+        const memory_uint64_t bit = memory_uint64_t(1) << (p_pages & 63);
+        if (p_set) {
+            free_run_bits_[p_pages >> 6] |= bit;
+        }
+        else {
+            free_run_bits_[p_pages >> 6] &= ~bit;
+        }
+    }
+
+    static void insert_free_run(MemorySpan* p_span) {
+        p_span->kind = MemorySpanKind::FREE;
+
+        // Only the boundary pages are needed to coalesce with neighbours
+        page_map_.set_range(p_span->start, 1, p_span);
+        page_map_.set_range(p_span->start + ((p_span->page_count - 1) << PAGE_SHIFT), 1, p_span);
+
+        const memory_size_t bucket = p_span->page_count < HEAP_BUCKETS ? p_span->page_count : HEAP_BUCKETS;
+        p_span->prev = nullptr;
+        p_span->next = free_runs_[bucket];
+        if (free_runs_[bucket]) {
+            free_runs_[bucket]->prev = p_span;
+        }
+        free_runs_[bucket] = p_span;
+        if (bucket < HEAP_BUCKETS) {
+            set_run_bit(bucket, true);
+        }
+    }
+
+    static void remove_free_run(MemorySpan* p_span) {
+        const memory_size_t bucket = p_span->page_count < HEAP_BUCKETS ? p_span->page_count : HEAP_BUCKETS;
+        if (p_span->prev) {
+            p_span->prev->next = p_span->next;
+        }
+        else {
+            free_runs_[bucket] = p_span->next;
+        }
+        if (p_span->next) {
+            p_span->next->prev = p_span->prev;
+        }
+        p_span->next = nullptr;
+        p_span->prev = nullptr;
+        if (bucket < HEAP_BUCKETS && free_runs_[bucket] == nullptr) {
+            set_run_bit(bucket, false);
+        }
+    }
+
+    static MemorySpan* find_free_run(memory_size_t p_pages) {
+        // Smallest exact-size bucket that can hold the request
+        for (memory_size_t word = p_pages >> 6; word < HEAP_BUCKETS / 64; word++) {
+            memory_uint64_t bits = free_run_bits_[word];
+            if (word == (p_pages >> 6)) {
+                bits &= ~memory_uint64_t(0) << (p_pages & 63);
+            }
+            if (bits) {
+                return free_runs_[(word << 6) + static_cast<memory_size_t>(log2_floor(bits & (~bits + 1)))];
+            }
+        }
+
+        // Best fit among the oversized runs
+        MemorySpan* best = nullptr;
+        for (MemorySpan* span = free_runs_[HEAP_BUCKETS]; span; span = span->next) {
+            if (span->page_count >= p_pages && (best == nullptr || span->page_count < best->page_count)) {
+                best = span;
+            }
+        }
+        return best;
+    }
+
+    static MEMORY_ALWAYS_INLINE memory_uint64_t now_ms() {
+        return static_cast<memory_uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    static MemorySpan* grow_heap(memory_size_t p_pages) {
+        const memory_size_t pages = p_pages > HEAP_GROW_PAGES ? p_pages : HEAP_GROW_PAGES;
+        memory_uint8_t* mem = static_cast<memory_uint8_t*>(memory_os_alloc_pages(pages << PAGE_SHIFT));
+        MEMORY_ERR_FAIL_NULL_V(mem, static_cast<MemorySpan*>(nullptr));
+
+        MemorySpan* span = span_allocator_.create();
+        if (span == nullptr) {
+            memory_os_free_pages(mem, pages << PAGE_SHIFT);
+            return nullptr;
+        }
+        span->start = mem;
+        span->page_count = pages;
+        // Fresh pages are not resident until touched
+        span->free_since = now_ms();
+        span->released = true;
+        insert_free_run(span);
+        return span;
+    }
+
+    // Take a run of exactly p_pages pages and map all of them to the returned span
+    static MemorySpan* alloc_pages(memory_size_t p_pages) {
+        MemorySpan* span = find_free_run(p_pages);
+        if (span == nullptr) {
+            span = grow_heap(p_pages);
+            if (span == nullptr) {
+                return nullptr;
+            }
+        }
+        remove_free_run(span);
+
+        if (span->page_count > p_pages) {
+            MemorySpan* rest = span_allocator_.create();
+            if (rest == nullptr) {
+                insert_free_run(span);
+                return nullptr;
+            }
+            rest->start = span->start + (p_pages << PAGE_SHIFT);
+            rest->page_count = span->page_count - p_pages;
+            rest->free_since = span->free_since;
+            rest->released = span->released;
+            span->page_count = p_pages;
+            insert_free_run(rest);
+        }
+
+        if (!page_map_.set_range(span->start, p_pages, span)) {
+            insert_free_run(span);
+            return nullptr;
+        }
+        return span;
+    }
+
+    // Give a run back to the page heap, merging it with free neighbours
+    static void free_pages(MemorySpan* p_span) {
+        MemorySpan* left = page_map_.get(p_span->start - Config::PAGE_SIZE);
+        if (left && left->kind == MemorySpanKind::FREE) {
+            remove_free_run(left);
+            p_span->start = left->start;
+            p_span->page_count += left->page_count;
+            span_allocator_.destroy(left);
+        }
+
+        MemorySpan* right = page_map_.get(p_span->start + (p_span->page_count << PAGE_SHIFT));
+        if (right && right->kind == MemorySpanKind::FREE) {
+            remove_free_run(right);
+            p_span->page_count += right->page_count;
+            span_allocator_.destroy(right);
+        }
+
+        // The merged run restarts its decay; releasing already released pages again is harmless
+        p_span->free_since = now_ms();
+        p_span->released = false;
+        insert_free_run(p_span);
+    }
+
+    static MemorySpan* create_small_span(memory_uint32_t p_class, CacheOwner* p_owner) {
+        std::lock_guard<LockType> guard(heap_lock_);
+        MemorySpan* span = alloc_pages(SPAN_PAGES);
+        if (span == nullptr) {
+            return nullptr;
+        }
+
+        span->kind = MemorySpanKind::SMALL;
+        span->owner.store(p_owner, std::memory_order_relaxed);
+        span->size_class = p_class;
+        span->block_size = MemorySizeClasses::size_of(p_class);
+        span->capacity = static_cast<memory_uint32_t>(MemorySizeClasses::SPAN_BYTES / span->block_size);
+        span->used = 0;
+        span->free_list = nullptr;
+        span->bump = span->start;
+        return span;
+    }
+
+    static void destroy_span(MemorySpan* p_span) {
+        std::lock_guard<LockType> guard(heap_lock_);
+        free_pages(p_span);
+    }
+
+    // POOLED hands requests above the small threshold to the system allocator behind a
+    // size word, so the size of every block the pool returns stays known
+    static constexpr memory_size_t SYSTEM_HEADER =
+        alignof(std::max_align_t) > sizeof(memory_size_t) ? alignof(std::max_align_t) : sizeof(memory_size_t);
+
+    template<bool p_ensure_zero>
+    static void* alloc_system(memory_size_t p_bytes) {
+        void* base = p_ensure_zero ? std::calloc(1, p_bytes + SYSTEM_HEADER) : std::malloc(p_bytes + SYSTEM_HEADER);
+        if (base == nullptr) {
+            return nullptr;
+        }
+        *static_cast<memory_size_t*>(base) = p_bytes;
+        return static_cast<memory_uint8_t*>(base) + SYSTEM_HEADER;
+    }
+
+    static void* realloc_system(void* p_ptr, memory_size_t p_bytes) {
+        void* base = std::realloc(static_cast<memory_uint8_t*>(p_ptr) - SYSTEM_HEADER, p_bytes + SYSTEM_HEADER);
+        if (base == nullptr) {
+            return nullptr;
+        }
+        *static_cast<memory_size_t*>(base) = p_bytes;
+        return static_cast<memory_uint8_t*>(base) + SYSTEM_HEADER;
+    }
+
+    static MEMORY_ALWAYS_INLINE void free_system(void* p_ptr) {
+        std::free(static_cast<memory_uint8_t*>(p_ptr) - SYSTEM_HEADER);
+    }
+
+    static MEMORY_ALWAYS_INLINE memory_size_t system_size(const void* p_ptr) {
+        return *reinterpret_cast<const memory_size_t*>(static_cast<const memory_uint8_t*>(p_ptr) - SYSTEM_HEADER);
+    }
+
+    // Medium requests take a dedicated run of pages from the page heap
+    static void* alloc_run(memory_size_t p_bytes) {
+        const memory_size_t pages = (p_bytes + Config::PAGE_SIZE - 1) >> PAGE_SHIFT;
+
+        std::lock_guard<LockType> guard(heap_lock_);
+        MemorySpan* span = alloc_pages(pages);
+        if (span == nullptr) {
+            return nullptr;
+        }
+        span->kind = MemorySpanKind::RUN;
+        span->block_size = pages << PAGE_SHIFT;
+        return span->start;
+    }
+
+    static void free_run(MemorySpan* p_span) {
+        std::lock_guard<LockType> guard(heap_lock_);
+        free_pages(p_span);
+    }
+
+    // Large requests are mapped straight from the OS and unmapped on free
+    static void* alloc_large(memory_size_t p_bytes) {
+        const memory_size_t granularity = memory_os_page_size() > Config::PAGE_SIZE ? memory_os_page_size() : Config::PAGE_SIZE;
+        const memory_size_t bytes = (p_bytes + granularity - 1) & ~(granularity - 1);
+        memory_uint8_t* mem = static_cast<memory_uint8_t*>(memory_os_alloc_pages(bytes));
+        MEMORY_ERR_FAIL_NULL_V(mem, static_cast<void*>(nullptr));
+
+        std::lock_guard<LockType> guard(heap_lock_);
+        MemorySpan* span = span_allocator_.create();
+        // Frees always pass the start of the mapping, so only its first page is mapped
+        if (span == nullptr || !page_map_.set_range(mem, 1, span)) {
+            if (span) {
+                span_allocator_.destroy(span);
+            }
+            memory_os_free_pages(mem, bytes);
+            return nullptr;
+        }
+        span->start = mem;
+        span->page_count = bytes >> PAGE_SHIFT;
+        span->kind = MemorySpanKind::LARGE;
+        span->block_size = bytes;
+        return mem;
+    }
+
+    static void free_large(MemorySpan* p_span) {
+        memory_uint8_t* mem = p_span->start;
+        const memory_size_t bytes = p_span->block_size;
+        {
+            std::lock_guard<LockType> guard(heap_lock_);
+            page_map_.set_range(mem, 1, nullptr);
+            span_allocator_.destroy(p_span);
+        }
+        memory_os_free_pages(mem, bytes);
+    }
+
+    // Grow or shrink a direct mapping by remapping its pages instead of copying them
+    static void* realloc_large(MemorySpan* p_span, memory_size_t p_bytes) {
+        const memory_size_t granularity = memory_os_page_size() > Config::PAGE_SIZE ? memory_os_page_size() : Config::PAGE_SIZE;
+        const memory_size_t bytes = (p_bytes + granularity - 1) & ~(granularity - 1);
+        memory_uint8_t* old_mem = p_span->start;
+        const memory_size_t old_bytes = p_span->block_size;
+
+        if constexpr (!MEMORY_OS_HAS_REMAP) {
+            return nullptr;
+        }
+
+        // Remap under the heap lock so a concurrent mapping that reuses old_mem registers after us
+        std::lock_guard<LockType> guard(heap_lock_);
+        memory_uint8_t* mem = static_cast<memory_uint8_t*>(memory_os_remap_pages(old_mem, old_bytes, bytes));
+        if (mem == nullptr) {
+            // Move onto a fresh mapping that is already in the page map, so nothing can fail
+            // once the pages have moved and the old range (free for any mmap user) is never touched again
+            memory_uint8_t* target = static_cast<memory_uint8_t*>(memory_os_alloc_pages(bytes));
+            if (target == nullptr) {
+                return nullptr;
+            }
+            if (!page_map_.set_range(target, 1, p_span)) {
+                memory_os_free_pages(target, bytes);
+                return nullptr;
+            }
+            mem = static_cast<memory_uint8_t*>(memory_os_remap_pages(old_mem, old_bytes, bytes, target));
+            if (mem == nullptr) {
+                page_map_.set_range(target, 1, nullptr);
+                memory_os_free_pages(target, bytes);
+                return nullptr;
+            }
+            page_map_.set_range(old_mem, 1, nullptr);
+        }
+        p_span->start = mem;
+        p_span->page_count = bytes >> PAGE_SHIFT;
+        p_span->block_size = bytes;
+        return mem;
+    }
+
+    // List holding a span that has free blocks: its owner's, or the class list (class lock held)
+    static MEMORY_ALWAYS_INLINE MemorySpan*& span_list(SizeClass& p_size_class, const MemorySpan* p_span) {
+        CacheOwner* owner = static_cast<CacheOwner*>(p_span->owner.load(std::memory_order_relaxed));
+        return owner ? owner->spans[p_span->size_class] : p_size_class.spans;
+    }
+
+    // Pop one block for p_owner, or for no cache at all (class lock held)
+    // Owners take from their own spans, then from unowned ones, adopting a span once it is
+    // empty since no other thread can hold its blocks then, and only then carve new spans.
+    static void* take_block(SizeClass& p_size_class, memory_uint32_t p_class, CacheOwner* p_owner = nullptr) {
+        MemorySpan*& list = p_owner ? p_owner->spans[p_class] : p_size_class.spans;
+        MemorySpan* span = list;
+        if (span == nullptr && p_owner) {
+            span = p_size_class.spans;
+            if (span && span->used == 0) {
+                unlink_span(p_size_class.spans, span);
+                span->owner.store(p_owner, std::memory_order_relaxed);
+                link_span(list, span);
+            }
+        }
+        if (MEMORY_UNLIKELY(span == nullptr)) {
+            span = create_small_span(p_class, p_owner);
+            if (span == nullptr) {
+                return nullptr;
+            }
+            link_span(list, span);
+        }
+
+        void* block = span->free_list;
+        if (block) {
+            span->free_list = *static_cast<void**>(block);
+        }
+        else {
+            // Carve lazily so untouched pages of a fresh span stay unbacked
+            block = span->bump;
+            span->bump += span->block_size;
+        }
+
+        if (++span->used == span->capacity) {
+            unlink_span(span_list(p_size_class, span), span);
+        }
+        return block;
+    }
+
+    // Push one block back onto its span (class lock held)
+    static void return_block(SizeClass& p_size_class, MemorySpan* p_span, void* p_ptr) {
+        *static_cast<void**>(p_ptr) = p_span->free_list;
+        p_span->free_list = p_ptr;
+
+        if (p_span->used-- == p_span->capacity) {
+            // A full span of an exited thread was left out of its lists; it becomes unowned now
+            CacheOwner* owner = static_cast<CacheOwner*>(p_span->owner.load(std::memory_order_relaxed));
+            if (owner && owner->retired.is_set()) {
+                p_span->owner.store(nullptr, std::memory_order_relaxed);
+            }
+            link_span(span_list(p_size_class, p_span), p_span);
+        }
+
+        if (p_span->used == 0) {
+            // Empty spans go back to the class so any cache can adopt them
+            if (p_span->owner.load(std::memory_order_relaxed)) {
+                unlink_span(span_list(p_size_class, p_span), p_span);
+                p_span->owner.store(nullptr, std::memory_order_relaxed);
+                link_span(p_size_class.spans, p_span);
+            }
+
+            // Keep a single empty span per class to absorb alloc/free churn
+            if (p_size_class.spans != p_span || p_span->next != nullptr) {
+                unlink_span(p_size_class.spans, p_span);
+                destroy_span(p_span);
+            }
+        }
+    }
+
+    static void* central_alloc(memory_uint32_t p_class) {
+        SizeClass& size_class = classes_[p_class];
+        std::lock_guard<LockType> guard(size_class.lock);
+        return take_block(size_class, p_class);
+    }
+
+    static void central_free(MemorySpan* p_span, void* p_ptr) {
+        SizeClass& size_class = classes_[p_span->size_class];
+        std::lock_guard<LockType> guard(size_class.lock);
+        return_block(size_class, p_span, p_ptr);
+    }
+
+    // Move up to p_count blocks into a linked chain under a single lock acquisition
+    static memory_uint32_t central_fetch(memory_uint32_t p_class, memory_uint32_t p_count, void** r_head, CacheOwner* p_owner) {
+        SizeClass& size_class = classes_[p_class];
+        std::lock_guard<LockType> guard(size_class.lock);
+
+        void* head = nullptr;
+        memory_uint32_t fetched = 0;
+        while (fetched < p_count) {
+            void* block = take_block(size_class, p_class, p_owner);
+            if (block == nullptr) {
+                break;
+            }
+            *static_cast<void**>(block) = head;
+            head = block;
+            ++fetched;
+        }
+        *r_head = head;
+        return fetched;
+    }
+
+    // Return a chain of p_count blocks of one class to their spans under a single lock acquisition
+    static void central_release(memory_uint32_t p_class, void* p_head, memory_uint32_t p_count) {
+        SizeClass& size_class = classes_[p_class];
+        std::lock_guard<LockType> guard(size_class.lock);
+
+        while (p_count-- > 0) {
+            void* next = *static_cast<void**>(p_head);
+            return_block(size_class, page_map_.get(p_head), p_head);
+            p_head = next;
+        }
+    }
+
+    // Thread caches are only worth their bookkeeping when several threads may allocate
+    static constexpr bool USE_THREAD_CACHE = Config::THREAD_POLICY != ThreadSafetyPolicy::NONE;
+
+    // Shared identity of a thread cache; outlives its thread and is recycled by later threads
+    struct alignas(Config::CACHE_LINE_SIZE) CacheOwner {
+        // MPSC queue of blocks freed by other threads: any thread pushes, the owner drains
+        SafeStack<Config::THREAD_POLICY> remote_frees;
+        SafeFlag<Config::THREAD_POLICY> retired;
+        CacheOwner* next_retired = nullptr;
+
+        // Owned spans with at least one free block, per class (class lock held)
+        MemorySpan* spans[MemorySizeClasses::COUNT] = {};
+    };
+
+    // Per-thread free lists, one per size class, touched without atomics or locks
+    struct ThreadCache {
+        struct FreeList {
+            void* head;
+            memory_uint32_t length;
+        };
+
+        FreeList lists[MemorySizeClasses::COUNT];
+        CacheOwner* owner;
+        bool registered;
+        bool finalized;
+    };
+
+    // Flushes the calling thread's cache back to the central pool on thread exit
+    struct ThreadCacheReaper {
+        ~ThreadCacheReaper() {
+            ThreadCache& cache = thread_cache_;
+            CacheOwner* owner = cache.owner;
+
+            // Retired before the drains: a remote free either lands before the last drain, or
+            // its push comes after that drain's write and sees the flag, then reclaims the block
+            owner->retired.set();
+            if (void* remote = owner->remote_frees.pop_all()) {
+                drain_remote_frees(cache, remote);
+            }
+            disown_spans(owner);
+            if (void* remote = owner->remote_frees.pop_all_synchronized()) {
+                drain_remote_frees(cache, remote);
+            }
+
+            for (memory_uint32_t i = 0; i < MemorySizeClasses::COUNT; i++) {
+                if (cache.lists[i].length > 0) {
+                    central_release(i, cache.lists[i].head, cache.lists[i].length);
+                    cache.lists[i].head = nullptr;
+                    cache.lists[i].length = 0;
+                }
+            }
+            cache.finalized = true;
+            recycle_owner(owner);
+        }
+    };
+
+    // Background thread running scavenge() a few times per decay period
+    struct Scavenger {
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::thread thread;
+        bool running = false;
+
+        ~Scavenger() {
+            stop();
+        }
+
+        void start() {
+            std::lock_guard<std::mutex> guard(mutex);
+            if (running) {
+                return;
+            }
+            running = true;
+            thread = std::thread([this] { run(); });
+        }
+
+        void stop() {
+            {
+                std::lock_guard<std::mutex> guard(mutex);
+                if (!running) {
+                    return;
+                }
+                running = false;
+            }
+            wake.notify_all();
+            thread.join();
+        }
+
+        void run() {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (running) {
+                const memory_uint64_t decay = MemoryRuntimeConfig::instance().scavenge_decay_ms;
+                const memory_uint64_t interval = decay / 4 > 10 ? decay / 4 : 10;
+                wake.wait_for(lock, std::chrono::milliseconds(interval), [this] { return !running; });
+                if (!running) {
+                    break;
+                }
+                lock.unlock();
+                scavenge(decay);
+                lock.lock();
+            }
+        }
+    };
+
+    static Scavenger& scavenger() {
+        static Scavenger instance;
+        return instance;
+    }
+
+    static thread_local ThreadCache thread_cache_;
+    static CacheOwner* retired_owners_;
+    static MemoryMetadataAllocator<CacheOwner> owner_allocator_;
+
+    static CacheOwner* acquire_owner() {
+        std::lock_guard<LockType> guard(heap_lock_);
+        CacheOwner* owner = retired_owners_;
+        if (owner) {
+            retired_owners_ = owner->next_retired;
+            owner->next_retired = nullptr;
+            owner->retired.clear();
+        }
+        else {
+            owner = owner_allocator_.create();
+        }
+        return owner;
+    }
+
+    // Spans with free blocks of a retired owner are handed to the class lists; full ones keep
+    // pointing at it, so frees to them stay local, until a block comes back to them
+    static void disown_spans(CacheOwner* p_owner) {
+        for (memory_uint32_t i = 0; i < MemorySizeClasses::COUNT; i++) {
+            SizeClass& size_class = classes_[i];
+            std::lock_guard<LockType> guard(size_class.lock);
+            while (MemorySpan* span = p_owner->spans[i]) {
+                unlink_span(p_owner->spans[i], span);
+                span->owner.store(nullptr, std::memory_order_relaxed);
+                link_span(size_class.spans, span);
+            }
+        }
+    }
+
+    // Make a drained, retired owner available to later threads
+    static void recycle_owner(CacheOwner* p_owner) {
+        std::lock_guard<LockType> guard(heap_lock_);
+        p_owner->next_retired = retired_owners_;
+        retired_owners_ = p_owner;
+    }
+
+    // Return blocks pushed to an owner that retired meanwhile; the push may have missed its
+    // final drain, so the pushing thread hands the queue's blocks back to their spans
+    static MEMORY_NO_INLINE void reclaim_remote_frees(CacheOwner* p_owner) {
+        void* chain = p_owner->remote_frees.pop_all();
+        while (chain) {
+            void* next = *static_cast<void**>(chain);
+            central_free(page_map_.get(chain), chain);
+            chain = next;
+        }
+    }
+
+    // Blocks moved between a thread cache and the central pool per transfer
+    static constexpr memory_uint32_t batch_size(memory_uint32_t p_class) {
+        const memory_size_t count = (32 * 1024) / MemorySizeClasses::size_of(p_class);
+        return static_cast<memory_uint32_t>(count < 4 ? 4 : (count > 64 ? 64 : count));
+    }
+
+    // Sort a chain of blocks freed by other threads into the owner's lists
+    static void drain_remote_frees(ThreadCache& p_cache, void* p_chain) {
+        while (p_chain) {
+            void* next = *static_cast<void**>(p_chain);
+            const memory_uint32_t size_class = page_map_.get(p_chain)->size_class;
+            typename ThreadCache::FreeList& list = p_cache.lists[size_class];
+            *static_cast<void**>(p_chain) = list.head;
+            list.head = p_chain;
+            if (++list.length > 2 * batch_size(size_class)) {
+                cache_flush(p_cache, size_class);
+            }
+            p_chain = next;
+        }
+    }
+
+    // Give the calling thread's cache an owner and flush it on thread exit
+    // Runs on the thread's first refill or local free; false if no owner could be created.
+    static MEMORY_NO_INLINE bool register_cache(ThreadCache& p_cache) {
+        CacheOwner* owner = acquire_owner();
+        if (owner == nullptr) {
+            return false;
+        }
+        static thread_local ThreadCacheReaper reaper;
+        (void)reaper;
+        p_cache.owner = owner;
+        p_cache.registered = true;
+        return true;
+    }
+
+    static MEMORY_NO_INLINE void* cache_refill(ThreadCache& p_cache, memory_uint32_t p_class) {
+        if (MEMORY_UNLIKELY(p_cache.finalized)) {
+            return central_alloc(p_class);
+        }
+        if (MEMORY_UNLIKELY(!p_cache.registered) && !register_cache(p_cache)) {
+            return central_alloc(p_class);
+        }
+
+        typename ThreadCache::FreeList& list = p_cache.lists[p_class];
+
+        // Blocks other threads handed back are drained in one batch before going central
+        if (void* remote = p_cache.owner->remote_frees.pop_all()) {
+            drain_remote_frees(p_cache, remote);
+            if (void* block = list.head) {
+                list.head = *static_cast<void**>(block);
+                --list.length;
+                return block;
+            }
+        }
+
+        // Lock-free fast path: adopt a whole batch another thread flushed
+        SizeClass& size_class = classes_[p_class];
+        if (void* batch = size_class.batches.pop()) {
+            size_class.batch_count.decrement();
+            list.head = *static_cast<void**>(batch);
+            list.length = batch_size(p_class) - 1;
+            return batch;
+        }
+
+        void* head = nullptr;
+        const memory_uint32_t fetched = central_fetch(p_class, batch_size(p_class), &head, p_cache.owner);
+        if (fetched == 0) {
+            return nullptr;
+        }
+
+        list.head = *static_cast<void**>(head);
+        list.length = fetched - 1;
+        return head;
+    }
+
+    // Whether a chain of p_count blocks holds any block of p_owner's spans
+    static bool holds_owned_blocks(void* p_head, memory_uint32_t p_count, const CacheOwner* p_owner) {
+        for (memory_uint32_t i = 0; i < p_count; i++) {
+            if (page_map_.get(p_head)->owner.load(std::memory_order_relaxed) == p_owner) {
+                return true;
+            }
+            p_head = *static_cast<void**>(p_head);
+        }
+        return false;
+    }
+
+    static MEMORY_NO_INLINE void cache_flush(ThreadCache& p_cache, memory_uint32_t p_class) {
+        // Hand the oldest half back so the hot head of the list stays local
+        typename ThreadCache::FreeList& list = p_cache.lists[p_class];
+        const memory_uint32_t keep = list.length - batch_size(p_class);
+        void* last_kept = list.head;
+        for (memory_uint32_t i = 1; i < keep; i++) {
+            last_kept = *static_cast<void**>(last_kept);
+        }
+        void* released = *static_cast<void**>(last_kept);
+        *static_cast<void**>(last_kept) = nullptr;
+        list.length = keep;
+
+        // Blocks of this cache's own spans go back to them: a thread adopting the batch
+        // would allocate from spans it does not own, and its own frees would then turn remote
+        SizeClass& size_class = classes_[p_class];
+        if (size_class.batch_count.get() < MAX_CENTRAL_BATCHES && !holds_owned_blocks(released, batch_size(p_class), p_cache.owner)) {
+            size_class.batches.push(released);
+            size_class.batch_count.increment();
+            return;
+        }
+        central_release(p_class, released, batch_size(p_class));
+    }
+
+    static MEMORY_ALWAYS_INLINE void* alloc_small(memory_uint32_t p_class) {
+        if constexpr (USE_THREAD_CACHE) {
+            ThreadCache& cache = thread_cache_;
+            typename ThreadCache::FreeList& list = cache.lists[p_class];
+            void* block = list.head;
+            if (MEMORY_LIKELY(block != nullptr)) {
+                list.head = *static_cast<void**>(block);
+                --list.length;
+                return block;
+            }
+            return cache_refill(cache, p_class);
+        }
+        else {
+            return central_alloc(p_class);
+        }
+    }
+
+    static MEMORY_ALWAYS_INLINE void free_small(MemorySpan* p_span, void* p_ptr) {
+        if constexpr (USE_THREAD_CACHE) {
+            ThreadCache& cache = thread_cache_;
+            if (MEMORY_UNLIKELY(cache.finalized)) {
+                central_free(p_span, p_ptr);
+                return;
+            }
+
+            // Blocks from another thread's span go back to that thread instead of this cache
+            CacheOwner* owner = static_cast<CacheOwner*>(p_span->owner.load(std::memory_order_relaxed));
+            if (owner != nullptr && owner != cache.owner && !owner->retired.is_set()) {
+                owner->remote_frees.push(p_ptr);
+                // The owner's last drain either took this block or ran before the push
+                if (MEMORY_UNLIKELY(owner->retired.is_set())) {
+                    reclaim_remote_frees(owner);
+                }
+                return;
+            }
+
+            // A thread that only frees must still hand its lists back when it exits
+            if (MEMORY_UNLIKELY(!cache.registered) && !register_cache(cache)) {
+                central_free(p_span, p_ptr);
+                return;
+            }
+
+            const memory_uint32_t size_class = p_span->size_class;
+            typename ThreadCache::FreeList& list = cache.lists[size_class];
+            *static_cast<void**>(p_ptr) = list.head;
+            list.head = p_ptr;
+            if (MEMORY_UNLIKELY(++list.length > 2 * batch_size(size_class))) {
+                cache_flush(cache, size_class);
+            }
+        }
+        else {
+            central_free(p_span, p_ptr);
+        }
+    }
+
+    // Release a block of any kind owned by this pool
+    static MEMORY_ALWAYS_INLINE void release(MemorySpan* p_span, void* p_ptr) {
+        if (MEMORY_LIKELY(p_span->kind == MemorySpanKind::SMALL)) {
+            free_small(p_span, p_ptr);
+        }
+        else if (p_span->kind == MemorySpanKind::RUN) {
+            free_run(p_span);
+        }
+        else {
+            free_large(p_span);
+        }
+    }
+
+    // Whether a block already satisfies p_bytes without moving
+    static bool fits_in_place(const MemorySpan* p_span, memory_size_t p_bytes) {
+        switch (p_span->kind) {
+            case MemorySpanKind::SMALL:
+                return p_bytes <= small_threshold() && MemorySizeClasses::index_of(p_bytes) == p_span->size_class;
+            case MemorySpanKind::RUN:
+                return p_bytes > small_threshold() && p_bytes <= large_threshold() &&
+                       ((p_bytes + Config::PAGE_SIZE - 1) >> PAGE_SHIFT) == p_span->page_count;
+            case MemorySpanKind::LARGE:
+                return p_bytes > large_threshold() && p_bytes <= p_span->block_size &&
+                       p_bytes > p_span->block_size - memory_os_page_size();
+            default:
+                return false;
+        }
+    }
+
+public:
+    // HYBRID routes medium and large requests to page runs and direct mappings
+    static constexpr bool ROUTE_BY_SIZE = Config::ALLOCATION_STRATEGY == MemoryAllocationStrategy::HYBRID;
+
+    // Largest request served from size classes (runtime threshold clamped to the class table)
+    static MEMORY_ALWAYS_INLINE memory_size_t small_threshold() {
+        const memory_size_t threshold = MemoryRuntimeConfig::instance().small_allocation_threshold;
+        return threshold < MemorySizeClasses::MAX_SIZE ? threshold : MemorySizeClasses::MAX_SIZE;
+    }
+
+    // Largest request served from page runs; anything bigger is mapped directly
+    static MEMORY_ALWAYS_INLINE memory_size_t large_threshold() {
+        return MemoryRuntimeConfig::instance().large_allocation_threshold;
+    }
+
+    template<bool p_ensure_zero = false>
+    static void* alloc(memory_size_t p_bytes) {
+        if (MEMORY_LIKELY(p_bytes <= small_threshold())) {
+            void* block = alloc_small(MemorySizeClasses::index_of(p_bytes));
+            if constexpr (p_ensure_zero) {
+                if (block) {
+                    std::memset(block, 0, p_bytes);
+                }
+            }
+            return block;
+        }
+
+        if constexpr (ROUTE_BY_SIZE) {
+            if (p_bytes <= large_threshold()) {
+                void* run = alloc_run(p_bytes);
+                if constexpr (p_ensure_zero) {
+                    if (run) {
+                        std::memset(run, 0, p_bytes);
+                    }
+                }
+                return run;
+            }
+            // Fresh mappings are already zero-filled
+            return alloc_large(p_bytes);
+        }
+        else {
+            return alloc_system<p_ensure_zero>(p_bytes);
+        }
+    }
+
+    // Allocate up to p_count blocks of p_bytes; returns how many were written to r_ptrs
+    // Small requests drain the thread cache (or take the class lock once) for the whole batch.
+    static memory_size_t alloc_batch(memory_size_t p_bytes, memory_size_t p_count, void** r_ptrs) {
+        if (p_bytes <= small_threshold()) {
+            const memory_uint32_t size_class = MemorySizeClasses::index_of(p_bytes);
+            if constexpr (USE_THREAD_CACHE) {
+                ThreadCache& cache = thread_cache_;
+                typename ThreadCache::FreeList& list = cache.lists[size_class];
+                for (memory_size_t i = 0; i < p_count; i++) {
+                    void* block = list.head;
+                    if (MEMORY_LIKELY(block != nullptr)) {
+                        list.head = *static_cast<void**>(block);
+                        --list.length;
+                    }
+                    else if ((block = cache_refill(cache, size_class)) == nullptr) {
+                        return i;
+                    }
+                    r_ptrs[i] = block;
+                }
+            }
+            else {
+                SizeClass& central = classes_[size_class];
+                std::lock_guard<LockType> guard(central.lock);
+                for (memory_size_t i = 0; i < p_count; i++) {
+                    if ((r_ptrs[i] = take_block(central, size_class)) == nullptr) {
+                        return i;
+                    }
+                }
+            }
+            return p_count;
+        }
+
+        for (memory_size_t i = 0; i < p_count; i++) {
+            if ((r_ptrs[i] = alloc(p_bytes)) == nullptr) {
+                return i;
+            }
+        }
+        return p_count;
+    }
+
+    static void* realloc(void* p_ptr, memory_size_t p_bytes) {
+        if (p_ptr == nullptr) {
+            return alloc(p_bytes);
+        }
+
+        MemorySpan* span = page_map_.get(p_ptr);
+        if (span == nullptr) {
+            if (p_bytes == 0) {
+                free_system(p_ptr);
+                return nullptr;
+            }
+            return realloc_system(p_ptr, p_bytes);
+        }
+
+        if (p_bytes == 0) {
+            release(span, p_ptr);
+            return nullptr;
+        }
+
+        if (fits_in_place(span, p_bytes)) {
+            return p_ptr;
+        }
+
+        if (span->kind == MemorySpanKind::LARGE && p_bytes > large_threshold()) {
+            if (void* mem = realloc_large(span, p_bytes)) {
+                return mem;
+            }
+        }
+
+        void* mem = alloc(p_bytes);
+        if (mem == nullptr) {
+            return nullptr;
+        }
+        std::memcpy(mem, p_ptr, p_bytes < span->block_size ? p_bytes : span->block_size);
+        release(span, p_ptr);
+        return mem;
+    }
+
+    // Bytes usable at a block returned by alloc, looked up without any per-block header
+    // (system blocks of POOLED report the size they were requested with)
+    static MEMORY_ALWAYS_INLINE memory_size_t usable_size(const void* p_ptr) {
+        const MemorySpan* span = page_map_.get(p_ptr);
+        return span ? span->block_size : system_size(p_ptr);
+    }
+
+    // Release the pages of free runs idle for at least p_decay_ms; returns the bytes released
+    // Pages stay mapped and are refaulted when the run is reused.
+    static memory_size_t scavenge(memory_uint64_t p_decay_ms) {
+        std::lock_guard<LockType> guard(heap_lock_);
+        const memory_uint64_t now = now_ms();
+        memory_size_t released = 0;
+        for (memory_size_t bucket = 0; bucket <= HEAP_BUCKETS; bucket++) {
+            for (MemorySpan* span = free_runs_[bucket]; span; span = span->next) {
+                if (!span->released && now - span->free_since >= p_decay_ms) {
+                    memory_os_release_pages(span->start, span->page_count << PAGE_SHIFT);
+                    span->released = true;
+                    released += span->page_count << PAGE_SHIFT;
+                }
+            }
+        }
+        return released;
+    }
+
+    // Start or stop the background scavenger (paced by MemoryRuntimeConfig::scavenge_decay_ms)
+    static void start_scavenger() {
+        static_assert(Config::THREAD_POLICY != ThreadSafetyPolicy::NONE, "The scavenger thread needs a thread-safe pool");
+        scavenger().start();
+    }
+
+    static void stop_scavenger() {
+        scavenger().stop();
+    }
+
+    // Whether alloc_aligned can serve the request from a naturally aligned block
+    // Spans and runs are only page aligned, and POOLED hands larger requests to the system.
+    static MEMORY_ALWAYS_INLINE bool can_align(memory_size_t p_bytes, memory_size_t p_alignment) {
+        if (p_alignment > Config::PAGE_SIZE) {
+            return false;
+        }
+        if (p_bytes <= small_threshold() && p_alignment <= MemorySizeClasses::MAX_SIZE) {
+            return true;
+        }
+        return ROUTE_BY_SIZE;
+    }
+
+    // Aligned block with no header: the smallest class whose size is a multiple of
+    // p_alignment (blocks sit at multiples of their size from a page boundary), or a page run
+    static void* alloc_aligned(memory_size_t p_bytes, memory_size_t p_alignment) {
+        MEMORY_DEV_ASSERT(can_align(p_bytes, p_alignment));
+
+        if (p_bytes <= small_threshold()) {
+            memory_uint32_t size_class = MemorySizeClasses::index_of(p_bytes > p_alignment ? p_bytes : p_alignment);
+            while (MemorySizeClasses::size_of(size_class) & (p_alignment - 1)) {
+                ++size_class;
+            }
+            return alloc_small(size_class);
+        }
+
+        if constexpr (ROUTE_BY_SIZE) {
+            if (p_bytes <= large_threshold()) {
+                return alloc_run(p_bytes);
+            }
+            return alloc_large(p_bytes);
+        }
+        else {
+            return nullptr;
+        }
+    }
+
+    // Whether p_ptr is the start of a pool block, as returned by alloc or alloc_aligned
+    // Pointers offset into a block (such as header-aligned allocations) never match.
+    static MEMORY_ALWAYS_INLINE bool is_block_start(const void* p_ptr) {
+        const MemorySpan* span = page_map_.get(p_ptr);
+        if (span == nullptr) {
+            return false;
+        }
+        const memory_size_t offset = static_cast<memory_size_t>(static_cast<const memory_uint8_t*>(p_ptr) - span->start);
+        if (span->kind == MemorySpanKind::SMALL) {
+            return offset % span->block_size == 0;
+        }
+        return offset == 0;
+    }
+
+    // Grow a natively aligned direct mapping by remapping it (page alignment is preserved)
+    // Returns nullptr when the block has to move through a copy instead.
+    static void* grow_aligned(void* p_ptr, memory_size_t p_bytes) {
+        if constexpr (ROUTE_BY_SIZE) {
+            MemorySpan* span = page_map_.get(p_ptr);
+            if (span->kind == MemorySpanKind::LARGE && p_bytes > large_threshold()) {
+                return realloc_large(span, p_bytes);
+            }
+        }
+        return nullptr;
+    }
+
+    // Returns the size of the released block
+    static memory_size_t free(void* p_ptr) {
+        MemorySpan* span = page_map_.get(p_ptr);
+        if (span == nullptr) {
+            const memory_size_t size = system_size(p_ptr);
+            free_system(p_ptr);
+            return size;
+        }
+        const memory_size_t size = span->block_size;
+        release(span, p_ptr);
+        return size;
+    }
+
+    // Free with the size passed at allocation (0 if unknown); returns the size of the released block
+    // POOLED never serves more than MAX_SIZE from classes, so such blocks skip the page map.
+    static MEMORY_ALWAYS_INLINE memory_size_t free_sized(void* p_ptr, memory_size_t p_bytes) {
+        if constexpr (!ROUTE_BY_SIZE) {
+            if (p_bytes > MemorySizeClasses::MAX_SIZE) {
+                MEMORY_DEV_ASSERT(page_map_.get(p_ptr) == nullptr && system_size(p_ptr) == p_bytes);
+                free_system(p_ptr);
+                return p_bytes;
+            }
+        }
+        return free(p_ptr);
+    }
+};
+
+// Static member definitions for MemoryPool
+template<typename Config>
+inline typename MemoryPool<Config>::SizeClass MemoryPool<Config>::classes_[MemorySizeClasses::COUNT]{};
+
+template<typename Config>
+inline typename MemoryPool<Config>::LockType MemoryPool<Config>::heap_lock_{};
+
+template<typename Config>
+inline MemorySpan* MemoryPool<Config>::free_runs_[MemoryPool<Config>::HEAP_BUCKETS + 1]{};
+
+template<typename Config>
+inline memory_uint64_t MemoryPool<Config>::free_run_bits_[MemoryPool<Config>::HEAP_BUCKETS / 64]{};
+
+template<typename Config>
+inline MemoryMetadataAllocator<MemorySpan> MemoryPool<Config>::span_allocator_{};
+
+template<typename Config>
+inline MemoryPageMap<MemoryPool<Config>::PAGE_SHIFT> MemoryPool<Config>::page_map_{};
+
+template<typename Config>
+inline thread_local typename MemoryPool<Config>::ThreadCache MemoryPool<Config>::thread_cache_{};
+
+template<typename Config>
+inline typename MemoryPool<Config>::CacheOwner* MemoryPool<Config>::retired_owners_ = nullptr;
+
+template<typename Config>
+inline MemoryMetadataAllocator<typename MemoryPool<Config>::CacheOwner> MemoryPool<Config>::owner_allocator_{};
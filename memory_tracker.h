@@ -11,9 +11,18 @@
 #include "error_handling.h"
 #include "thread_safe.h"
 #include "memory_config.h"
+#include "memory_os.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <unordered_map>
 #include <string>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 // Forward declarations
 template<typename Config>
@@ -54,6 +63,234 @@ struct MemoryStats {
     }
 };
 
+// Allocation counts by requested size
+// Four buckets per power of two, so neighbouring pool size classes stay apart; sizes 0-3
+// get a bucket each and everything from 2^MAX_SIZE_LOG2 bytes up shares the last one.
+struct MemorySizeHistogram {
+    static constexpr memory_uint32_t MAX_SIZE_LOG2 = 40;
+    static constexpr memory_size_t BUCKET_COUNT = 4 * (MAX_SIZE_LOG2 - 1) + 1;
+    
+    memory_uint64_t counts[BUCKET_COUNT] = {};
+    
+    static MEMORY_ALWAYS_INLINE memory_size_t bucket_of(memory_size_t p_size) {
+        if (p_size < 4) {
+            return p_size;
+        }
+        const memory_uint32_t log2 = log2_floor(p_size);
+        if (log2 >= MAX_SIZE_LOG2) {
+            return BUCKET_COUNT - 1;
+        }
+        return 4 * (log2 - 1) + ((p_size >> (log2 - 2)) & 3);
+    }
+    
+    // Smallest size counted in p_bucket
+    static memory_uint64_t bucket_min_size(memory_size_t p_bucket) {
+        if (p_bucket < 4) {
+            return p_bucket;
+        }
+        if (p_bucket == BUCKET_COUNT - 1) {
+            return memory_uint64_t(1) << MAX_SIZE_LOG2;
+        }
+        return (4 + (p_bucket & 3)) << (p_bucket / 4 - 1);
+    }
+    
+    memory_uint64_t get_total() const {
+        memory_uint64_t total = 0;
+        for (memory_uint64_t count : counts) {
+            total += count;
+        }
+        return total;
+    }
+};
+
+// Live allocation picked by MemoryHeapSampler
+struct HeapSample {
+    static constexpr int MAX_DEPTH = 32;
+    
+    void* ptr;
+    memory_size_t size;
+    memory_uint64_t weight;     // Bytes of allocation this sample stands for
+    const char* function;       // Allocation entry point
+    memory_uint64_t timestamp;  // Milliseconds, steady clock
+    int depth;
+    void* stack[MAX_DEPTH];     // Return addresses, innermost first
+};
+
+// Byte-based Poisson sampling of live allocations for production heap profiles
+// Each thread counts allocated bytes down from an exponentially distributed distance with
+// mean MemoryRuntimeConfig::heap_sample_interval and records the allocation that crosses zero.
+// Summing the weights of the live samples is an unbiased estimate of the heap by call stack.
+class MemoryHeapSampler {
+private:
+    struct ThreadState {
+        memory_int64_t bytes_until_sample;
+        memory_uint64_t rng;
+        bool armed;
+        bool busy;
+    };
+    
+    struct Registry {
+        std::mutex mutex;
+        std::unordered_map<void*, HeapSample> samples;
+    };
+    
+    // While sampling is off, threads look at the interval again after this many bytes
+    static constexpr memory_int64_t DISABLED_RECHECK = 1024 * 1024;
+    
+    // Counting filter over sampled addresses so frees of unsampled blocks skip the registry
+    static constexpr memory_uint32_t FILTER_BITS = 16;
+    
+    static std::atomic<memory_uint64_t> live_count_;
+    static std::atomic<memory_uint16_t> filter_[1u << FILTER_BITS];
+    static thread_local ThreadState thread_state_;
+    
+    // Never destroyed, so frees during static destruction stay safe
+    static Registry& registry() {
+        static Registry* registry = new Registry;
+        return *registry;
+    }
+    
+    static MEMORY_ALWAYS_INLINE memory_uint32_t filter_slot(void* p_ptr) {
+        return static_cast<memory_uint32_t>(((reinterpret_cast<memory_uintptr_t>(p_ptr) >> 4) * 0x9E3779B97F4A7C15ull) >> (64 - FILTER_BITS));
+    }
+    
+    // Exponentially distributed distance to the next sample
+    static memory_int64_t next_distance(ThreadState& p_state, memory_size_t p_interval) {
+        // xorshift64*
+        p_state.rng ^= p_state.rng >> 12;
+        p_state.rng ^= p_state.rng << 25;
+        p_state.rng ^= p_state.rng >> 27;
+        const memory_uint64_t bits = p_state.rng * 0x2545F4914F6CDD1Dull;
+        const double u = (static_cast<double>(bits >> 11) + 1.0) * (1.0 / 9007199254740992.0); // (0, 1]
+        const double distance = -std::log(u) * static_cast<double>(p_interval);
+        return distance < 1.0 ? 1 : static_cast<memory_int64_t>(distance);
+    }
+    
+    static MEMORY_NO_INLINE void record(void* p_ptr, memory_size_t p_size, memory_size_t p_interval, const char* p_context) {
+        HeapSample sample;
+        sample.ptr = p_ptr;
+        sample.size = p_size;
+        // A block of size s is picked with probability 1 - e^(-s/interval)
+        const double probability = 1.0 - std::exp(-static_cast<double>(p_size) / static_cast<double>(p_interval));
+        sample.weight = probability > 0.0 ? static_cast<memory_uint64_t>(static_cast<double>(p_size) / probability + 0.5) : p_interval;
+        sample.function = p_context;
+        sample.timestamp = static_cast<memory_uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+        // Skip record() and sample_slow()
+        sample.depth = memory_os_walk_frames(sample.stack, HeapSample::MAX_DEPTH, 2);
+        
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        auto result = reg.samples.insert_or_assign(p_ptr, sample);
+        if (result.second) {
+            filter_[filter_slot(p_ptr)].fetch_add(1, std::memory_order_relaxed);
+            live_count_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    
+    static MEMORY_NO_INLINE void sample_slow(ThreadState& p_state, void* p_ptr, memory_size_t p_size, const char* p_context) {
+        const memory_size_t interval = MemoryRuntimeConfig::instance().heap_sample_interval;
+        if (interval == 0) {
+            p_state.bytes_until_sample = DISABLED_RECHECK;
+            p_state.armed = false;
+            return;
+        }
+        
+        if (MEMORY_UNLIKELY(!p_state.armed)) {
+            // Fresh thread or sampling just switched on: start a new interval rather than sampling
+            if (p_state.rng == 0) {
+                p_state.rng = (reinterpret_cast<memory_uintptr_t>(&p_state) * 0x9E3779B97F4A7C15ull) ^
+                              static_cast<memory_uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()) ^ 1;
+            }
+            p_state.armed = true;
+            p_state.bytes_until_sample = next_distance(p_state, interval);
+            return;
+        }
+        
+        p_state.bytes_until_sample = next_distance(p_state, interval);
+        if (p_state.busy) {
+            // Allocation made by the sampler itself
+            return;
+        }
+        p_state.busy = true;
+        record(p_ptr, p_size, interval, p_context);
+        p_state.busy = false;
+    }
+    
+    static MEMORY_NO_INLINE void remove_slow(void* p_ptr) {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        if (reg.samples.erase(p_ptr) != 0) {
+            filter_[filter_slot(p_ptr)].fetch_sub(1, std::memory_order_relaxed);
+            live_count_.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+    
+public:
+    // Count p_size bytes against this thread's sampling distance; records p_ptr if it crosses it
+    static MEMORY_ALWAYS_INLINE void on_allocation(void* p_ptr, memory_size_t p_size, const char* p_context) {
+        ThreadState& state = thread_state_;
+        state.bytes_until_sample -= static_cast<memory_int64_t>(p_size);
+        if (MEMORY_UNLIKELY(state.bytes_until_sample < 0)) {
+            sample_slow(state, p_ptr, p_size, p_context);
+        }
+    }
+    
+    // Drop p_ptr's sample, if any; must run before the block can be handed out again
+    static MEMORY_ALWAYS_INLINE void on_deallocation(void* p_ptr) {
+        if (MEMORY_UNLIKELY(live_count_.load(std::memory_order_relaxed) != 0) &&
+            filter_[filter_slot(p_ptr)].load(std::memory_order_relaxed) != 0) {
+            remove_slow(p_ptr);
+        }
+    }
+    
+    // Snapshot of the live samples
+    static std::vector<HeapSample> get_samples() {
+        std::vector<HeapSample> samples;
+        ThreadState& state = thread_state_;
+        const bool busy = state.busy;
+        state.busy = true;
+        {
+            Registry& reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            samples.reserve(reg.samples.size());
+            for (const auto& entry : reg.samples) {
+                samples.push_back(entry.second);
+            }
+        }
+        state.busy = busy;
+        return samples;
+    }
+    
+    // Estimated live heap in bytes (sum of sample weights)
+    static memory_uint64_t get_estimated_usage() {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        memory_uint64_t total = 0;
+        for (const auto& entry : reg.samples) {
+            total += entry.second.weight;
+        }
+        return total;
+    }
+    
+    static void dump_samples() {
+        for (const HeapSample& sample : get_samples()) {
+            std::string message = "Sample: " + std::to_string(sample.size) + " bytes (~" + std::to_string(sample.weight) + " bytes) from " +
+                                  (sample.function ? sample.function : "unknown");
+            for (int i = 0; i < sample.depth; i++) {
+                char frame[2 + 2 * sizeof(void*) + 2];
+                std::snprintf(frame, sizeof(frame), " %p", sample.stack[i]);
+                message += frame;
+            }
+            _memory_report_error(MemoryErrorType::MEM_WARNING, MEMORY_FUNCTION_STR, __FILE__, __LINE__, message.c_str());
+        }
+    }
+};
+
+inline std::atomic<memory_uint64_t> MemoryHeapSampler::live_count_{ 0 };
+inline std::atomic<memory_uint16_t> MemoryHeapSampler::filter_[1u << MemoryHeapSampler::FILTER_BITS]{};
+inline thread_local MemoryHeapSampler::ThreadState MemoryHeapSampler::thread_state_{};
+
 // No tracking implementation
 template<typename Config>
 class MemoryTracker {
@@ -74,6 +311,30 @@ public:
         // No-op
     }
     
+    static MEMORY_ALWAYS_INLINE void track_allocation_batch([[maybe_unused]] memory_size_t total_size, [[maybe_unused]] memory_size_t count, [[maybe_unused]] const char* file = nullptr, [[maybe_unused]] int line = 0, [[maybe_unused]] const char* function = nullptr) {
+        // No-op
+    }
+    
+    static MEMORY_ALWAYS_INLINE void track_deallocation_batch([[maybe_unused]] memory_size_t total_size, [[maybe_unused]] memory_size_t count, [[maybe_unused]] const char* file = nullptr, [[maybe_unused]] int line = 0, [[maybe_unused]] const char* function = nullptr) {
+        // No-op
+    }
+    
+    // Size the caller asked for, before pool rounding or padding (feeds the size histogram)
+    static MEMORY_ALWAYS_INLINE void track_request_size([[maybe_unused]] memory_size_t size, [[maybe_unused]] memory_size_t count = 1) {
+        // No-op
+    }
+    
+    // Per-block hooks for address-keyed trackers (FULL); called after a block is handed out
+    // and before it is released. p_realloc marks the two halves of a reallocation, and
+    // untrack_block returns the size that was recorded (0 when blocks are not recorded).
+    static MEMORY_ALWAYS_INLINE void track_block([[maybe_unused]] void* ptr, [[maybe_unused]] memory_size_t size, [[maybe_unused]] bool p_realloc = false) {
+        // No-op
+    }
+    
+    static MEMORY_ALWAYS_INLINE memory_size_t untrack_block([[maybe_unused]] void* ptr, [[maybe_unused]] bool p_realloc = false) {
+        return 0;
+    }
+    
     static MEMORY_ALWAYS_INLINE memory_uint64_t get_current_usage() {
         return 0;
     }
@@ -90,6 +351,10 @@ public:
         return MemoryStats{};
     }
     
+    static MEMORY_ALWAYS_INLINE MemorySizeHistogram get_size_histogram() {
+        return MemorySizeHistogram{};
+    }
+    
     static MEMORY_ALWAYS_INLINE void reset_stats() {
         // No-op
     }
@@ -99,96 +364,481 @@ public:
     }
 };
 
-// Basic tracking implementation - template specialization
-template<typename Config>
-class BasicMemoryTracker {
-    static_assert(Config::TRACKING_LEVEL == MemoryTrackingLevel::BASIC, "Use for basic tracking only");
+// Default MemoryThreadCounters retire step: fold every counter as it is
+inline void memory_thread_counters_keep(memory_int64_t*) {}
+
+// Signed counters kept in per-thread slabs and summed on read
+// Each thread updates its own cache-aligned slab with relaxed loads and stores, so hot
+// paths never contend on a shared line; readers walk the registered slabs under a lock.
+// Every slab is a single-writer seqlock: the owner bumps its sequence around an update
+// (wait-free, no read-modify-write) and readers retry a slab until they see it unchanged,
+// so the counters of one update are always read together. Slabs of exited threads are
+// folded into a retired total, which also takes updates from threads whose thread-local
+// storage is already being torn down. Tag keeps the slabs of different users apart.
+// Retire sees an exiting thread's counters before they are folded and may consume some
+// of them (zeroing what it took).
+template<typename Tag, memory_size_t Count, memory_size_t CacheLineSize = 64, void (*Retire)(memory_int64_t*) = &memory_thread_counters_keep>
+class MemoryThreadCounters {
+public:
+    struct alignas(CacheLineSize) Slab {
+        std::atomic<memory_uint32_t> sequence; // Odd while the owner is updating
+        std::atomic<memory_int64_t> values[Count];
+        Slab* prev;
+        Slab* next;
+        bool registered;
+        bool finalized;
+        
+        // Owner-only updates: readers may see a stale value, never a torn one. Stores are
+        // release so a reader that sees one also sees the odd sequence written before it.
+        MEMORY_ALWAYS_INLINE memory_int64_t get(memory_size_t p_index) const {
+            return values[p_index].load(std::memory_order_relaxed);
+        }
+        
+        MEMORY_ALWAYS_INLINE void set(memory_size_t p_index, memory_int64_t p_value) {
+            values[p_index].store(p_value, std::memory_order_release);
+        }
+        
+        MEMORY_ALWAYS_INLINE void add(memory_size_t p_index, memory_int64_t p_delta) {
+            set(p_index, get(p_index) + p_delta);
+        }
+        
+        // Bracket a group of updates that readers must see together
+        MEMORY_ALWAYS_INLINE void begin_update() {
+            sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+        
+        MEMORY_ALWAYS_INLINE void end_update() {
+            sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+        
+        // Copy of every counter from a single point between updates
+        void read(memory_int64_t* r_values) const {
+            for (memory_uint32_t attempt = 0;; attempt++) {
+                const memory_uint32_t before = sequence.load(std::memory_order_acquire);
+                if ((before & 1) == 0) {
+                    for (memory_size_t i = 0; i < Count; i++) {
+                        r_values[i] = values[i].load(std::memory_order_acquire);
+                    }
+                    if (sequence.load(std::memory_order_relaxed) == before) {
+                        return;
+                    }
+                }
+                // The owner may have been preempted mid-update
+                if (attempt >= 64) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    };
+    
+private:
+    struct SlabReaper {
+        ~SlabReaper() {
+            Slab& slab = slab_;
+            std::lock_guard<std::mutex> lock(registry_mutex_);
+            memory_int64_t values[Count];
+            for (memory_size_t i = 0; i < Count; i++) {
+                values[i] = slab.get(i);
+            }
+            Retire(values);
+            for (memory_size_t i = 0; i < Count; i++) {
+                retired_[i].fetch_add(values[i], std::memory_order_relaxed);
+                slab.set(i, 0);
+            }
+            if (slab.prev) {
+                slab.prev->next = slab.next;
+            }
+            else {
+                slabs_ = slab.next;
+            }
+            if (slab.next) {
+                slab.next->prev = slab.prev;
+            }
+            slab.registered = false;
+            slab.finalized = true;
+        }
+    };
+    
+    static std::mutex registry_mutex_;
+    static Slab* slabs_;
+    static std::atomic<memory_int64_t> retired_[Count];
+    static thread_local Slab slab_;
+    
+    static MEMORY_NO_INLINE Slab* register_slab(Slab& p_slab) {
+        if (p_slab.finalized) {
+            return nullptr;
+        }
+        static thread_local SlabReaper reaper;
+        (void)reaper;
+        
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        p_slab.prev = nullptr;
+        p_slab.next = slabs_;
+        if (slabs_) {
+            slabs_->prev = &p_slab;
+        }
+        slabs_ = &p_slab;
+        p_slab.registered = true;
+        return &p_slab;
+    }
     
 public:
-    using CounterType = SafeNumeric<memory_uint64_t, Config::THREAD_POLICY>;
+    // Calling thread's slab, or nullptr once its thread-local storage is torn down
+    static MEMORY_ALWAYS_INLINE Slab* local() {
+        Slab& slab = slab_;
+        if (MEMORY_LIKELY(slab.registered)) {
+            return &slab;
+        }
+        return register_slab(slab);
+    }
+    
+    static MEMORY_ALWAYS_INLINE void add(memory_size_t p_index, memory_int64_t p_delta) {
+        Slab* slab = local();
+        if (MEMORY_LIKELY(slab != nullptr)) {
+            slab->begin_update();
+            slab->add(p_index, p_delta);
+            slab->end_update();
+        }
+        else {
+            add_shared(p_index, p_delta);
+        }
+    }
+    
+    // Update the shared total directly (for threads without a slab)
+    static void add_shared(memory_size_t p_index, memory_int64_t p_delta) {
+        retired_[p_index].fetch_add(p_delta, std::memory_order_acq_rel);
+    }
+    
+    // Totals of every counter across live and exited threads
+    // Each slab is read consistently; anything that happened before an update a slab shows
+    // is visible to the slabs read after it.
+    static void sum(memory_int64_t* r_values) {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        for (memory_size_t i = 0; i < Count; i++) {
+            r_values[i] = retired_[i].load(std::memory_order_acquire);
+        }
+        memory_int64_t values[Count];
+        for (const Slab* slab = slabs_; slab; slab = slab->next) {
+            slab->read(values);
+            for (memory_size_t i = 0; i < Count; i++) {
+                r_values[i] += values[i];
+            }
+        }
+    }
+    
+    static memory_int64_t sum(memory_size_t p_index) {
+        memory_int64_t values[Count];
+        sum(values);
+        return values[p_index];
+    }
+    
+    // Zero the totals by offsetting the retired counts; slabs stay owned by their threads
+    static void reset() {
+        memory_int64_t values[Count];
+        sum(values);
+        for (memory_size_t i = 0; i < Count; i++) {
+            retired_[i].fetch_sub(values[i], std::memory_order_relaxed);
+        }
+    }
+};
+
+template<typename Tag, memory_size_t Count, memory_size_t CacheLineSize, void (*Retire)(memory_int64_t*)>
+inline std::mutex MemoryThreadCounters<Tag, Count, CacheLineSize, Retire>::registry_mutex_{};
+
+template<typename Tag, memory_size_t Count, memory_size_t CacheLineSize, void (*Retire)(memory_int64_t*)>
+inline typename MemoryThreadCounters<Tag, Count, CacheLineSize, Retire>::Slab* MemoryThreadCounters<Tag, Count, CacheLineSize, Retire>::slabs_ = nullptr;
+
+template<typename Tag, memory_size_t Count, memory_size_t CacheLineSize, void (*Retire)(memory_int64_t*)>
+inline std::atomic<memory_int64_t> MemoryThreadCounters<Tag, Count, CacheLineSize, Retire>::retired_[Count]{};
+
+template<typename Tag, memory_size_t Count, memory_size_t CacheLineSize, void (*Retire)(memory_int64_t*)>
+inline thread_local typename MemoryThreadCounters<Tag, Count, CacheLineSize, Retire>::Slab MemoryThreadCounters<Tag, Count, CacheLineSize, Retire>::slab_{};
+
+// Allocation statistics shared by the tracking levels
+// Thread-safe configs count in per-thread slabs (MemoryThreadCounters), each a seqlock, so
+// writers are never paused. Usage is kept as monotonic allocated and freed byte totals.
+// A snapshot takes two passes and reports frees from the first and allocations from the
+// second: a free is ordered after its allocation, so frees never exceed allocations.
+// Usage comes from the second pass alone, clamped at zero.
+// For the peak, each thread publishes its usage change to a shared counter in steps of
+// PUBLISH_BYTES, and on exit, and snapshots raise it to the usage they see, so between
+// snapshots the peak may be off by up to PUBLISH_BYTES per thread. The published usage is
+// signed: a thread that frees blocks allocated elsewhere can publish before their owners.
+template<typename Config>
+class MemoryStatCounters {
+public:
+    static constexpr bool PER_THREAD = Config::THREAD_POLICY != ThreadSafetyPolicy::NONE;
+    static constexpr memory_int64_t PUBLISH_BYTES = 64 * 1024;
+    
+    // Shared counters on their own cache lines; written once per PUBLISH_BYTES at most
+    using CounterType = SafeAlignedNumeric<memory_uint64_t, memory_scalar_policy(Config::THREAD_POLICY), AtomicOrderPolicy::RELAXED, Config::CACHE_LINE_SIZE>;
+    using UsageType = SafeAlignedNumeric<memory_int64_t, memory_scalar_policy(Config::THREAD_POLICY), AtomicOrderPolicy::RELAXED, Config::CACHE_LINE_SIZE>;
     
 private:
-    static CounterType current_usage_;
+    enum Counter : memory_size_t {
+        COUNTER_ALLOCATIONS,
+        COUNTER_DEALLOCATIONS,
+        COUNTER_REALLOCATIONS,
+        COUNTER_BYTES_ALLOCATED,
+        COUNTER_BYTES_FREED,
+        COUNTER_PENDING_USAGE,  // Usage change not yet published to published_usage_
+        COUNTER_MAX
+    };
+    
+    struct HistogramTag {};
+    
+    // An exiting thread publishes what it had pending, so no usage change is lost
+    static void retire_counters(memory_int64_t* p_values) {
+        publish_usage(p_values[COUNTER_PENDING_USAGE]);
+        p_values[COUNTER_PENDING_USAGE] = 0;
+    }
+    
+    using ThreadCounters = MemoryThreadCounters<MemoryStatCounters<Config>, COUNTER_MAX, Config::CACHE_LINE_SIZE, &MemoryStatCounters<Config>::retire_counters>;
+    using HistogramCounters = MemoryThreadCounters<HistogramTag, MemorySizeHistogram::BUCKET_COUNT, Config::CACHE_LINE_SIZE>;
+    
+    static UsageType published_usage_;
     static CounterType peak_usage_;
-    static CounterType allocation_count_;
-    static CounterType deallocation_count_;
-    static CounterType reallocation_count_;
+    
+    // Unsynchronized configs only
+    static memory_int64_t values_[COUNTER_MAX];
+    static memory_uint64_t histogram_[MemorySizeHistogram::BUCKET_COUNT];
+    
+    static void publish_usage(memory_int64_t p_delta) {
+        const memory_int64_t usage = published_usage_.add(p_delta);
+        if (p_delta > 0 && usage > 0) {
+            peak_usage_.exchange_if_greater(static_cast<memory_uint64_t>(usage));
+        }
+    }
+    
+    static MEMORY_ALWAYS_INLINE void record(Counter p_counter, memory_int64_t p_events, memory_int64_t p_allocated, memory_int64_t p_freed) {
+        if constexpr (PER_THREAD) {
+            typename ThreadCounters::Slab* slab = ThreadCounters::local();
+            if (MEMORY_UNLIKELY(slab == nullptr)) {
+                ThreadCounters::add_shared(p_counter, p_events);
+                ThreadCounters::add_shared(COUNTER_BYTES_ALLOCATED, p_allocated);
+                ThreadCounters::add_shared(COUNTER_BYTES_FREED, p_freed);
+                publish_usage(p_allocated - p_freed);
+                return;
+            }
+            
+            slab->begin_update();
+            slab->add(p_counter, p_events);
+            if (p_allocated != 0) {
+                slab->add(COUNTER_BYTES_ALLOCATED, p_allocated);
+            }
+            if (p_freed != 0) {
+                slab->add(COUNTER_BYTES_FREED, p_freed);
+            }
+            const memory_int64_t pending = slab->get(COUNTER_PENDING_USAGE) + p_allocated - p_freed;
+            const bool publish = pending > PUBLISH_BYTES || pending < -PUBLISH_BYTES;
+            slab->set(COUNTER_PENDING_USAGE, publish ? 0 : pending);
+            slab->end_update();
+            
+            if (MEMORY_UNLIKELY(publish)) {
+                publish_usage(pending);
+            }
+        }
+        else {
+            values_[p_counter] += p_events;
+            values_[COUNTER_BYTES_ALLOCATED] += p_allocated;
+            values_[COUNTER_BYTES_FREED] += p_freed;
+            const memory_int64_t usage = values_[COUNTER_BYTES_ALLOCATED] - values_[COUNTER_BYTES_FREED];
+            if (usage > 0) {
+                peak_usage_.exchange_if_greater(static_cast<memory_uint64_t>(usage));
+            }
+        }
+    }
+    
+public:
+    // p_count blocks totalling p_bytes were handed out
+    static MEMORY_ALWAYS_INLINE void on_allocation(memory_size_t p_count, memory_size_t p_bytes) {
+        record(COUNTER_ALLOCATIONS, static_cast<memory_int64_t>(p_count), static_cast<memory_int64_t>(p_bytes), 0);
+    }
+    
+    static MEMORY_ALWAYS_INLINE void on_deallocation(memory_size_t p_count, memory_size_t p_bytes) {
+        record(COUNTER_DEALLOCATIONS, static_cast<memory_int64_t>(p_count), 0, static_cast<memory_int64_t>(p_bytes));
+    }
+    
+    // A reallocation frees the old size and allocates the new one
+    static MEMORY_ALWAYS_INLINE void on_reallocation(memory_size_t p_count, memory_size_t p_old_bytes, memory_size_t p_new_bytes) {
+        record(COUNTER_REALLOCATIONS, static_cast<memory_int64_t>(p_count), static_cast<memory_int64_t>(p_new_bytes), static_cast<memory_int64_t>(p_old_bytes));
+    }
+    
+    // p_count requests of p_size bytes each
+    static MEMORY_ALWAYS_INLINE void on_request(memory_size_t p_size, memory_size_t p_count) {
+        const memory_size_t bucket = MemorySizeHistogram::bucket_of(p_size);
+        if constexpr (PER_THREAD) {
+            HistogramCounters::add(bucket, static_cast<memory_int64_t>(p_count));
+        }
+        else {
+            histogram_[bucket] += p_count;
+        }
+    }
+    
+    static MemorySizeHistogram size_histogram() {
+        MemorySizeHistogram histogram;
+        if constexpr (PER_THREAD) {
+            memory_int64_t counts[MemorySizeHistogram::BUCKET_COUNT];
+            HistogramCounters::sum(counts);
+            for (memory_size_t i = 0; i < MemorySizeHistogram::BUCKET_COUNT; i++) {
+                histogram.counts[i] = counts[i] > 0 ? static_cast<memory_uint64_t>(counts[i]) : 0;
+            }
+        }
+        else {
+            for (memory_size_t i = 0; i < MemorySizeHistogram::BUCKET_COUNT; i++) {
+                histogram.counts[i] = histogram_[i];
+            }
+        }
+        return histogram;
+    }
+    
+    static MemoryStats snapshot() {
+        memory_int64_t early[COUNTER_MAX];
+        memory_int64_t late[COUNTER_MAX];
+        if constexpr (PER_THREAD) {
+            // Frees from the first pass, everything else from the second
+            ThreadCounters::sum(early);
+            ThreadCounters::sum(late);
+        }
+        else {
+            for (memory_size_t i = 0; i < COUNTER_MAX; i++) {
+                early[i] = late[i] = values_[i];
+            }
+        }
+        
+        MemoryStats stats;
+        const memory_int64_t usage = late[COUNTER_BYTES_ALLOCATED] - late[COUNTER_BYTES_FREED];
+        stats.current_usage = usage > 0 ? static_cast<memory_uint64_t>(usage) : 0;
+        stats.peak_usage = peak_usage_.exchange_if_greater(stats.current_usage);
+        stats.allocation_count = static_cast<memory_uint64_t>(late[COUNTER_ALLOCATIONS]);
+        stats.deallocation_count = static_cast<memory_uint64_t>(early[COUNTER_DEALLOCATIONS]);
+        stats.reallocation_count = static_cast<memory_uint64_t>(late[COUNTER_REALLOCATIONS]);
+        stats.total_allocated = static_cast<memory_uint64_t>(late[COUNTER_BYTES_ALLOCATED]);
+        stats.total_freed = static_cast<memory_uint64_t>(early[COUNTER_BYTES_FREED]);
+        return stats;
+    }
+    
+    static void reset() {
+        if constexpr (PER_THREAD) {
+            ThreadCounters::reset();
+            HistogramCounters::reset();
+        }
+        else {
+            for (memory_int64_t& value : values_) {
+                value = 0;
+            }
+            for (memory_uint64_t& count : histogram_) {
+                count = 0;
+            }
+        }
+        published_usage_.set(0);
+        peak_usage_.set(0);
+    }
+};
+
+template<typename Config>
+inline typename MemoryStatCounters<Config>::UsageType MemoryStatCounters<Config>::published_usage_{};
+
+template<typename Config>
+inline typename MemoryStatCounters<Config>::CounterType MemoryStatCounters<Config>::peak_usage_{};
+
+template<typename Config>
+inline memory_int64_t MemoryStatCounters<Config>::values_[MemoryStatCounters<Config>::COUNTER_MAX]{};
+
+template<typename Config>
+inline memory_uint64_t MemoryStatCounters<Config>::histogram_[MemorySizeHistogram::BUCKET_COUNT]{};
+
+// Basic tracking implementation - template specialization
+template<typename Config>
+class BasicMemoryTracker {
+    static_assert(Config::TRACKING_LEVEL == MemoryTrackingLevel::BASIC, "Use for basic tracking only");
     
 public:
+    using Stats = MemoryStatCounters<Config>;
+    
     static MEMORY_ALWAYS_INLINE void track_allocation(memory_size_t size, [[maybe_unused]] const char* file = nullptr, [[maybe_unused]] int line = 0, [[maybe_unused]] const char* function = nullptr) {
         if constexpr (Config::ENABLE_TRACKING) {
-            memory_uint64_t new_usage = current_usage_.add(size);
-            peak_usage_.exchange_if_greater(new_usage);
-            allocation_count_.increment();
+            Stats::on_allocation(1, size);
         }
     }
     
     static MEMORY_ALWAYS_INLINE void track_deallocation(memory_size_t size, [[maybe_unused]] const char* file = nullptr, [[maybe_unused]] int line = 0, [[maybe_unused]] const char* function = nullptr) {
         if constexpr (Config::ENABLE_TRACKING) {
-            current_usage_.sub(size);
-            deallocation_count_.increment();
+            Stats::on_deallocation(1, size);
         }
     }
     
     static MEMORY_ALWAYS_INLINE void track_reallocation(memory_size_t old_size, memory_size_t new_size, [[maybe_unused]] const char* file = nullptr, [[maybe_unused]] int line = 0, [[maybe_unused]] const char* function = nullptr) {
         if constexpr (Config::ENABLE_TRACKING) {
-            if (new_size > old_size) {
-                memory_uint64_t new_usage = current_usage_.add(new_size - old_size);
-                peak_usage_.exchange_if_greater(new_usage);
-            } else if (old_size > new_size) {
-                current_usage_.sub(old_size - new_size);
-            }
-            reallocation_count_.increment();
+            Stats::on_reallocation(1, old_size, new_size);
         }
     }
     
-    static MEMORY_ALWAYS_INLINE memory_uint64_t get_current_usage() {
+    // Batch hooks: one counter update for a whole group of allocations
+    static MEMORY_ALWAYS_INLINE void track_allocation_batch(memory_size_t total_size, memory_size_t count, [[maybe_unused]] const char* file = nullptr, [[maybe_unused]] int line = 0, [[maybe_unused]] const char* function = nullptr) {
         if constexpr (Config::ENABLE_TRACKING) {
-            return current_usage_.get();
-        } else {
-            return 0;
+            if (count == 0) {
+                return;
+            }
+            Stats::on_allocation(count, total_size);
         }
     }
     
-    static MEMORY_ALWAYS_INLINE memory_uint64_t get_peak_usage() {
+    static MEMORY_ALWAYS_INLINE void track_deallocation_batch(memory_size_t total_size, memory_size_t count, [[maybe_unused]] const char* file = nullptr, [[maybe_unused]] int line = 0, [[maybe_unused]] const char* function = nullptr) {
         if constexpr (Config::ENABLE_TRACKING) {
-            return peak_usage_.get();
-        } else {
-            return 0;
+            if (count == 0) {
+                return;
+            }
+            Stats::on_deallocation(count, total_size);
         }
     }
     
-    static MEMORY_ALWAYS_INLINE memory_uint64_t get_allocation_count() {
+    // Size the caller asked for, before pool rounding or padding (feeds the size histogram)
+    static MEMORY_ALWAYS_INLINE void track_request_size(memory_size_t size, memory_size_t count = 1) {
         if constexpr (Config::ENABLE_TRACKING) {
-            return allocation_count_.get();
-        } else {
-            return 0;
+            Stats::on_request(size, count);
         }
     }
     
+    static MEMORY_ALWAYS_INLINE void track_block([[maybe_unused]] void* ptr, [[maybe_unused]] memory_size_t size, [[maybe_unused]] bool p_realloc = false) {
+        // No-op
+    }
+    
+    static MEMORY_ALWAYS_INLINE memory_size_t untrack_block([[maybe_unused]] void* ptr, [[maybe_unused]] bool p_realloc = false) {
+        return 0;
+    }
+    
+    static memory_uint64_t get_current_usage() {
+        return get_stats().current_usage;
+    }
+    
+    static memory_uint64_t get_peak_usage() {
+        return get_stats().peak_usage;
+    }
+    
+    static memory_uint64_t get_allocation_count() {
+        return get_stats().allocation_count;
+    }
+    
     static MemoryStats get_stats() {
         if constexpr (Config::ENABLE_TRACKING) {
-            MemoryStats stats;
-            stats.current_usage = current_usage_.get();
-            stats.peak_usage = peak_usage_.get();
-            stats.allocation_count = allocation_count_.get();
-            stats.deallocation_count = deallocation_count_.get();
-            stats.reallocation_count = reallocation_count_.get();
-            stats.total_allocated = stats.allocation_count; // Simplified
-            stats.total_freed = stats.deallocation_count;   // Simplified
-            return stats;
+            return Stats::snapshot();
         } else {
             return MemoryStats{};
         }
     }
     
+    static MemorySizeHistogram get_size_histogram() {
+        if constexpr (Config::ENABLE_TRACKING) {
+            return Stats::size_histogram();
+        } else {
+            return MemorySizeHistogram{};
+        }
+    }
+    
     static void reset_stats() {
         if constexpr (Config::ENABLE_TRACKING) {
-            current_usage_.set(0);
-            peak_usage_.set(0);
-            allocation_count_.set(0);
-            deallocation_count_.set(0);
-            reallocation_count_.set(0);
+            Stats::reset();
         }
     }
     
@@ -205,138 +855,274 @@ public:
     }
 };
 
+// Concurrent address-keyed table for trackers that record every live block
+// Sharded by address hash; each shard is an open-addressing table with linear probing and
+// backward-shift deletion behind its own lock. Slots come straight from OS pages, so
+// recording a block never allocates through the allocator being tracked.
+template<typename Value, ThreadSafetyPolicy Policy, memory_size_t CacheLineSize = 64>
+class MemoryBlockTable {
+public:
+    static constexpr memory_uint32_t SHARD_BITS = Policy == ThreadSafetyPolicy::NONE ? 0 : 6;
+    static constexpr memory_uint32_t SHARD_COUNT = 1u << SHARD_BITS;
+    
+private:
+    static constexpr memory_size_t INITIAL_CAPACITY = 256; // Slots per shard on first use
+    
+    struct Slot {
+        void* key;
+        Value value;
+    };
+    
+    struct alignas(CacheLineSize) Shard {
+        SafeLock<Policy> lock;
+        Slot* slots = nullptr;
+        memory_size_t capacity = 0;
+        memory_size_t count = 0;
+    };
+    
+    // Never torn down: blocks may still be released during static destruction
+    Shard shards_[SHARD_COUNT];
+    
+    static MEMORY_ALWAYS_INLINE memory_uint64_t hash(void* p_key) {
+        const memory_uint64_t h = (reinterpret_cast<memory_uintptr_t>(p_key) >> 4) * 0x9E3779B97F4A7C15ull;
+        return h ^ (h >> 32);
+    }
+    
+    MEMORY_ALWAYS_INLINE Shard& shard_of(memory_uint64_t p_hash) {
+        if constexpr (SHARD_BITS == 0) {
+            return shards_[0];
+        }
+        else {
+            return shards_[p_hash >> (64 - SHARD_BITS)];
+        }
+    }
+    
+    static bool grow(Shard& p_shard) {
+        const memory_size_t capacity = p_shard.capacity ? p_shard.capacity * 2 : INITIAL_CAPACITY;
+        Slot* slots = static_cast<Slot*>(memory_os_alloc_pages(capacity * sizeof(Slot)));
+        if (slots == nullptr) {
+            return false;
+        }
+        for (memory_size_t i = 0; i < p_shard.capacity; i++) {
+            const Slot& slot = p_shard.slots[i];
+            if (slot.key == nullptr) {
+                continue;
+            }
+            memory_size_t index = hash(slot.key) & (capacity - 1);
+            while (slots[index].key != nullptr) {
+                index = (index + 1) & (capacity - 1);
+            }
+            slots[index] = slot;
+        }
+        if (p_shard.slots) {
+            memory_os_free_pages(p_shard.slots, p_shard.capacity * sizeof(Slot));
+        }
+        p_shard.slots = slots;
+        p_shard.capacity = capacity;
+        return true;
+    }
+    
+public:
+    // Insert or replace p_key; false if the shard could not grow
+    bool insert(void* p_key, const Value& p_value) {
+        const memory_uint64_t h = hash(p_key);
+        Shard& shard = shard_of(h);
+        std::lock_guard<SafeLock<Policy>> guard(shard.lock);
+        
+        // Keep the load factor under 3/4
+        if ((shard.count + 1) * 4 > shard.capacity * 3 && !grow(shard)) {
+            return false;
+        }
+        memory_size_t index = h & (shard.capacity - 1);
+        while (shard.slots[index].key != nullptr && shard.slots[index].key != p_key) {
+            index = (index + 1) & (shard.capacity - 1);
+        }
+        if (shard.slots[index].key == nullptr) {
+            shard.count++;
+        }
+        shard.slots[index].key = p_key;
+        shard.slots[index].value = p_value;
+        return true;
+    }
+    
+    // Remove p_key, copying its value to r_value; false if it was not present
+    bool remove(void* p_key, Value* r_value = nullptr) {
+        const memory_uint64_t h = hash(p_key);
+        Shard& shard = shard_of(h);
+        std::lock_guard<SafeLock<Policy>> guard(shard.lock);
+        
+        if (shard.count == 0) {
+            return false;
+        }
+        const memory_size_t mask = shard.capacity - 1;
+        memory_size_t index = h & mask;
+        while (shard.slots[index].key != p_key) {
+            if (shard.slots[index].key == nullptr) {
+                return false;
+            }
+            index = (index + 1) & mask;
+        }
+        if (r_value) {
+            *r_value = shard.slots[index].value;
+        }
+        
+        // Shift later entries of the probe run back so lookups never need tombstones
+        memory_size_t hole = index;
+        memory_size_t next = (hole + 1) & mask;
+        while (shard.slots[next].key != nullptr) {
+            const memory_size_t home = hash(shard.slots[next].key) & mask;
+            // Move the entry unless its home lies cyclically in (hole, next]
+            if (((next - home) & mask) >= ((next - hole) & mask)) {
+                shard.slots[hole] = shard.slots[next];
+                hole = next;
+            }
+            next = (next + 1) & mask;
+        }
+        shard.slots[hole].key = nullptr;
+        shard.count--;
+        return true;
+    }
+    
+    // Visit every entry, one shard locked at a time
+    template<typename Function>
+    void for_each(Function&& p_function) {
+        for (Shard& shard : shards_) {
+            std::lock_guard<SafeLock<Policy>> guard(shard.lock);
+            for (memory_size_t i = 0; i < shard.capacity; i++) {
+                if (shard.slots[i].key != nullptr) {
+                    p_function(shard.slots[i].key, shard.slots[i].value);
+                }
+            }
+        }
+    }
+    
+    void clear() {
+        for (Shard& shard : shards_) {
+            std::lock_guard<SafeLock<Policy>> guard(shard.lock);
+            for (memory_size_t i = 0; i < shard.capacity; i++) {
+                shard.slots[i].key = nullptr;
+            }
+            shard.count = 0;
+        }
+    }
+};
+
 // Detailed tracking implementation
 template<typename Config>
 class DetailedMemoryTracker {
     static_assert(Config::TRACKING_LEVEL == MemoryTrackingLevel::DETAILED, "Use for detailed tracking only");
     
 public:
-    using CounterType = SafeNumeric<memory_uint64_t, Config::THREAD_POLICY>;
+    using Stats = MemoryStatCounters<Config>;
     
 private:
-    static CounterType current_usage_;
-    static CounterType peak_usage_;
-    static CounterType allocation_count_;
-    static CounterType deallocation_count_;
-    static CounterType reallocation_count_;
-    static CounterType next_allocation_id_;
+    static SafeAlignedNumeric<memory_uint64_t, memory_scalar_policy(Config::THREAD_POLICY), AtomicOrderPolicy::RELAXED, Config::CACHE_LINE_SIZE> next_allocation_id_;
     
-    // Thread-safe allocation tracking
-    static std::mutex allocations_mutex_;
-    static std::unordered_map<void*, AllocationInfo> allocations_;
+    // Live blocks by address
+    static MemoryBlockTable<AllocationInfo, Config::THREAD_POLICY, Config::CACHE_LINE_SIZE> allocations_;
     
 public:
-    static void track_allocation(memory_size_t size, [[maybe_unused]] const char* file = nullptr, [[maybe_unused]] int line = 0, [[maybe_unused]] const char* function = nullptr) {
-        if constexpr (Config::ENABLE_TRACKING) {
-            memory_uint64_t new_usage = current_usage_.add(size);
-            peak_usage_.exchange_if_greater(new_usage);
-            allocation_count_.increment();
-            
-            // Store allocation info if detailed tracking is enabled
-            if constexpr (Config::TRACKING_LEVEL == MemoryTrackingLevel::DETAILED) {
-                            [[maybe_unused]] memory_uint64_t alloc_id = next_allocation_id_.increment();
-            // Note: We would need the actual pointer to store this properly
-            // This is a simplified version
-            }
-        }
+    // Blocks are accounted in track_block/untrack_block, which see their addresses
+    static MEMORY_ALWAYS_INLINE void track_allocation([[maybe_unused]] memory_size_t size, [[maybe_unused]] const char* file = nullptr, [[maybe_unused]] int line = 0, [[maybe_unused]] const char* function = nullptr) {
     }
     
     static void track_allocation_with_ptr(void* ptr, memory_size_t size, const char* file = nullptr, int line = 0, const char* function = nullptr) {
         if constexpr (Config::ENABLE_TRACKING && Config::TRACKING_LEVEL == MemoryTrackingLevel::DETAILED) {
-            memory_uint64_t new_usage = current_usage_.add(size);
-            peak_usage_.exchange_if_greater(new_usage);
-            allocation_count_.increment();
+            Stats::on_allocation(1, size);
             
             memory_uint64_t alloc_id = next_allocation_id_.increment();
             memory_uint64_t timestamp = 0; // Would need actual timestamp implementation
             
-            std::lock_guard<std::mutex> lock(allocations_mutex_);
-            allocations_[ptr] = AllocationInfo(size, file, line, function, timestamp, alloc_id);
+            allocations_.insert(ptr, AllocationInfo(size, file, line, function, timestamp, alloc_id));
         }
     }
     
-    static void track_deallocation(memory_size_t size, [[maybe_unused]] const char* file = nullptr, [[maybe_unused]] int line = 0, [[maybe_unused]] const char* function = nullptr) {
-        if constexpr (Config::ENABLE_TRACKING) {
-            current_usage_.sub(size);
-            deallocation_count_.increment();
-        }
+    static MEMORY_ALWAYS_INLINE void track_deallocation([[maybe_unused]] memory_size_t size, [[maybe_unused]] const char* file = nullptr, [[maybe_unused]] int line = 0, [[maybe_unused]] const char* function = nullptr) {
     }
     
     static void track_deallocation_with_ptr(void* ptr, [[maybe_unused]] const char* file = nullptr, [[maybe_unused]] int line = 0, [[maybe_unused]] const char* function = nullptr) {
         if constexpr (Config::ENABLE_TRACKING && Config::TRACKING_LEVEL == MemoryTrackingLevel::DETAILED) {
-            std::lock_guard<std::mutex> lock(allocations_mutex_);
-            auto it = allocations_.find(ptr);
-            if (it != allocations_.end()) {
-                current_usage_.sub(it->second.size);
-                allocations_.erase(it);
-            }
-            deallocation_count_.increment();
+            AllocationInfo info;
+            Stats::on_deallocation(1, allocations_.remove(ptr, &info) ? info.size : 0);
         }
     }
     
-    static void track_reallocation(memory_size_t old_size, memory_size_t new_size, [[maybe_unused]] const char* file = nullptr, [[maybe_unused]] int line = 0, [[maybe_unused]] const char* function = nullptr) {
+    static MEMORY_ALWAYS_INLINE void track_reallocation([[maybe_unused]] memory_size_t old_size, [[maybe_unused]] memory_size_t new_size, [[maybe_unused]] const char* file = nullptr, [[maybe_unused]] int line = 0, [[maybe_unused]] const char* function = nullptr) {
         if constexpr (Config::ENABLE_TRACKING) {
-            if (new_size > old_size) {
-                memory_uint64_t new_usage = current_usage_.add(new_size - old_size);
-                peak_usage_.exchange_if_greater(new_usage);
-            } else if (old_size > new_size) {
-                current_usage_.sub(old_size - new_size);
-            }
-            reallocation_count_.increment();
+            Stats::on_reallocation(1, 0, 0);
         }
     }
     
-    static memory_uint64_t get_current_usage() {
+    static MEMORY_ALWAYS_INLINE void track_allocation_batch([[maybe_unused]] memory_size_t total_size, [[maybe_unused]] memory_size_t count, [[maybe_unused]] const char* file = nullptr, [[maybe_unused]] int line = 0, [[maybe_unused]] const char* function = nullptr) {
+    }
+    
+    static MEMORY_ALWAYS_INLINE void track_deallocation_batch([[maybe_unused]] memory_size_t total_size, [[maybe_unused]] memory_size_t count, [[maybe_unused]] const char* file = nullptr, [[maybe_unused]] int line = 0, [[maybe_unused]] const char* function = nullptr) {
+    }
+    
+    // Size the caller asked for, before pool rounding or padding (feeds the size histogram)
+    static MEMORY_ALWAYS_INLINE void track_request_size(memory_size_t size, memory_size_t count = 1) {
         if constexpr (Config::ENABLE_TRACKING) {
-            return current_usage_.get();
-        } else {
-            return 0;
+            Stats::on_request(size, count);
         }
     }
     
-    static memory_uint64_t get_peak_usage() {
+    static void track_block(void* ptr, memory_size_t size, bool p_realloc = false) {
         if constexpr (Config::ENABLE_TRACKING) {
-            return peak_usage_.get();
-        } else {
-            return 0;
+            Stats::on_allocation(p_realloc ? 0 : 1, size);
+            
+            memory_uint64_t alloc_id = next_allocation_id_.increment();
+            allocations_.insert(ptr, AllocationInfo(size, nullptr, 0, nullptr, 0, alloc_id));
         }
     }
     
-    static memory_uint64_t get_allocation_count() {
+    static memory_size_t untrack_block(void* ptr, bool p_realloc = false) {
         if constexpr (Config::ENABLE_TRACKING) {
-            return allocation_count_.get();
-        } else {
+            AllocationInfo info;
+            if (!allocations_.remove(ptr, &info)) {
+                return 0;
+            }
+            Stats::on_deallocation(p_realloc ? 0 : 1, info.size);
+            return info.size;
+        }
+        else {
             return 0;
         }
     }
     
+    static memory_uint64_t get_current_usage() {
+        return get_stats().current_usage;
+    }
+    
+    static memory_uint64_t get_peak_usage() {
+        return get_stats().peak_usage;
+    }
+    
+    static memory_uint64_t get_allocation_count() {
+        return get_stats().allocation_count;
+    }
+    
     static MemoryStats get_stats() {
         if constexpr (Config::ENABLE_TRACKING) {
-            MemoryStats stats;
-            stats.current_usage = current_usage_.get();
-            stats.peak_usage = peak_usage_.get();
-            stats.allocation_count = allocation_count_.get();
-            stats.deallocation_count = deallocation_count_.get();
-            stats.reallocation_count = reallocation_count_.get();
-            stats.total_allocated = stats.allocation_count; // Simplified
-            stats.total_freed = stats.deallocation_count;   // Simplified
-            return stats;
+            return Stats::snapshot();
         } else {
             return MemoryStats{};
         }
     }
     
+    static MemorySizeHistogram get_size_histogram() {
+        if constexpr (Config::ENABLE_TRACKING) {
+            return Stats::size_histogram();
+        } else {
+            return MemorySizeHistogram{};
+        }
+    }
+    
     static void reset_stats() {
         if constexpr (Config::ENABLE_TRACKING) {
-            current_usage_.set(0);
-            peak_usage_.set(0);
-            allocation_count_.set(0);
-            deallocation_count_.set(0);
-            reallocation_count_.set(0);
+            Stats::reset();
             next_allocation_id_.set(0);
             
             if constexpr (Config::TRACKING_LEVEL == MemoryTrackingLevel::DETAILED) {
-                std::lock_guard<std::mutex> lock(allocations_mutex_);
                 allocations_.clear();
             }
         }
@@ -344,58 +1130,298 @@ public:
     
     static void dump_allocations() {
         if constexpr (Config::ENABLE_TRACKING && Config::TRACKING_LEVEL == MemoryTrackingLevel::DETAILED) {
-            std::lock_guard<std::mutex> lock(allocations_mutex_);
-            for (const auto& [ptr, info] : allocations_) {
+            allocations_.for_each([](void* ptr, const AllocationInfo& info) {
+                char location[32];
+                snprintf(location, sizeof(location), "%p", ptr);
                 std::string message = "Leak: " + std::to_string(info.size) + " bytes at " + 
-                                     (info.file ? info.file : "unknown") + ":" + std::to_string(info.line);
-                _memory_report_error(MemoryErrorType::WARNING, info.function ? info.function : "unknown", 
+                                     (info.file ? info.file + (":" + std::to_string(info.line)) : std::string(location)) +
+                                     " (allocation #" + std::to_string(info.allocation_id) + ")";
+                _memory_report_error(MemoryErrorType::MEM_WARNING, info.function ? info.function : "unknown", 
                                    info.file ? info.file : "unknown", info.line, message.c_str());
-            }
+            });
         }
     }
 };
 
-// Static member definitions would go in a .cpp file
-// For header-only implementation, we use inline static
-template<typename Config>
-inline typename BasicMemoryTracker<Config>::CounterType BasicMemoryTracker<Config>::current_usage_{};
-
-template<typename Config>
-inline typename BasicMemoryTracker<Config>::CounterType BasicMemoryTracker<Config>::peak_usage_{};
-
-template<typename Config>
-inline typename BasicMemoryTracker<Config>::CounterType BasicMemoryTracker<Config>::allocation_count_{};
-
-template<typename Config>
-inline typename BasicMemoryTracker<Config>::CounterType BasicMemoryTracker<Config>::deallocation_count_{};
-
-template<typename Config>
-inline typename BasicMemoryTracker<Config>::CounterType BasicMemoryTracker<Config>::reallocation_count_{};
-
-// Static member definitions for DetailedMemoryTracker
-template<typename Config>
-inline typename DetailedMemoryTracker<Config>::CounterType DetailedMemoryTracker<Config>::current_usage_{};
-
-template<typename Config>
-inline typename DetailedMemoryTracker<Config>::CounterType DetailedMemoryTracker<Config>::peak_usage_{};
+// Interned call stacks addressed by 32-bit ids (0 = unknown)
+// Lock-free hash-consing into a fixed open-addressing table: identical stacks share one
+// entry, entries are never removed, and stacks that do not fit map to id 0.
+class MemoryStackTable {
+public:
+    static constexpr int MAX_DEPTH = 24;
+    static constexpr memory_uint32_t CAPACITY = 1u << 16;
+    
+private:
+    static constexpr memory_uint32_t MAX_PROBES = 128;
+    
+    enum : memory_uint32_t {
+        ENTRY_EMPTY,
+        ENTRY_WRITING,
+        ENTRY_READY
+    };
+    
+    struct Entry {
+        std::atomic<memory_uint32_t> state;
+        memory_uint32_t depth;
+        memory_uint64_t hash;
+        void* frames[MAX_DEPTH];
+    };
+    
+    static std::atomic<Entry*> entries_;
+    static std::atomic<memory_uint32_t> count_;
+    
+    // Zeroed OS pages (all entries empty), mapped on first use
+    static Entry* entries() {
+        Entry* table = entries_.load(std::memory_order_acquire);
+        if (MEMORY_LIKELY(table != nullptr)) {
+            return table;
+        }
+        Entry* fresh = static_cast<Entry*>(memory_os_alloc_pages(sizeof(Entry) * CAPACITY));
+        if (fresh == nullptr) {
+            return nullptr;
+        }
+        if (!entries_.compare_exchange_strong(table, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            memory_os_free_pages(fresh, sizeof(Entry) * CAPACITY);
+            return table;
+        }
+        return fresh;
+    }
+    
+    static memory_uint64_t hash_frames(void* const* p_frames, int p_depth) {
+        memory_uint64_t hash = 0xCBF29CE484222325ull;
+        for (int i = 0; i < p_depth; i++) {
+            hash = (hash ^ reinterpret_cast<memory_uintptr_t>(p_frames[i])) * 0x100000001B3ull;
+            hash ^= hash >> 29;
+        }
+        return hash;
+    }
+    
+public:
+    // Id of the stack p_frames[0..p_depth), adding it on first sight
+    static memory_uint32_t intern(void* const* p_frames, int p_depth) {
+        if (p_depth <= 0) {
+            return 0;
+        }
+        Entry* table = entries();
+        if (table == nullptr) {
+            return 0;
+        }
+        
+        const memory_uint32_t depth = static_cast<memory_uint32_t>(p_depth > MAX_DEPTH ? MAX_DEPTH : p_depth);
+        const memory_uint64_t hash = hash_frames(p_frames, static_cast<int>(depth));
+        memory_uint32_t index = static_cast<memory_uint32_t>(hash) & (CAPACITY - 1);
+        
+        for (memory_uint32_t probe = 0; probe < MAX_PROBES; probe++, index = (index + 1) & (CAPACITY - 1)) {
+            Entry& entry = table[index];
+            memory_uint32_t state = entry.state.load(std::memory_order_acquire);
+            if (state == ENTRY_EMPTY) {
+                if (entry.state.compare_exchange_strong(state, ENTRY_WRITING, std::memory_order_acquire)) {
+                    entry.hash = hash;
+                    entry.depth = depth;
+                    std::memcpy(entry.frames, p_frames, depth * sizeof(void*));
+                    entry.state.store(ENTRY_READY, std::memory_order_release);
+                    count_.fetch_add(1, std::memory_order_relaxed);
+                    return index + 1;
+                }
+            }
+            // Another thread is publishing this entry; it only takes a copy of a few frames
+            while (state == ENTRY_WRITING) {
+                std::this_thread::yield();
+                state = entry.state.load(std::memory_order_acquire);
+            }
+            if (entry.hash == hash && entry.depth == depth &&
+                std::memcmp(entry.frames, p_frames, depth * sizeof(void*)) == 0) {
+                return index + 1;
+            }
+        }
+        return 0;
+    }
+    
+    // Copy stack p_id into r_frames (MAX_DEPTH slots); returns its depth, 0 if unknown
+    static int get(memory_uint32_t p_id, void** r_frames) {
+        Entry* table = entries_.load(std::memory_order_acquire);
+        if (p_id == 0 || p_id > CAPACITY || table == nullptr) {
+            return 0;
+        }
+        const Entry& entry = table[p_id - 1];
+        if (entry.state.load(std::memory_order_acquire) != ENTRY_READY) {
+            return 0;
+        }
+        std::memcpy(r_frames, entry.frames, entry.depth * sizeof(void*));
+        return static_cast<int>(entry.depth);
+    }
+    
+    static memory_uint32_t get_count() {
+        return count_.load(std::memory_order_relaxed);
+    }
+};
 
-template<typename Config>
-inline typename DetailedMemoryTracker<Config>::CounterType DetailedMemoryTracker<Config>::allocation_count_{};
+inline std::atomic<MemoryStackTable::Entry*> MemoryStackTable::entries_{ nullptr };
+inline std::atomic<memory_uint32_t> MemoryStackTable::count_{ 0 };
 
-template<typename Config>
-inline typename DetailedMemoryTracker<Config>::CounterType DetailedMemoryTracker<Config>::deallocation_count_{};
+// Live bytes attributed to one call stack
+struct StackUsage {
+    memory_uint32_t stack_id;
+    memory_uint64_t bytes;
+    memory_uint64_t count;
+};
 
+// Full tracking: every live block keyed by address with its size and a 32-bit stack id
+// Stacks are captured by walking frame pointers (see memory_os_walk_frames) and interned
+// in MemoryStackTable, so live heap can be attributed to the code that allocated it.
 template<typename Config>
-inline typename DetailedMemoryTracker<Config>::CounterType DetailedMemoryTracker<Config>::reallocation_count_{};
+class FullMemoryTracker {
+    static_assert(Config::TRACKING_LEVEL == MemoryTrackingLevel::FULL, "Use for full tracking only");
+    
+public:
+    using Stats = MemoryStatCounters<Config>;
+    
+private:
+    struct BlockRecord {
+        memory_size_t size;
+        memory_uint32_t stack_id;
+    };
+    
+    
+    // Live blocks by address
+    static MemoryBlockTable<BlockRecord, Config::THREAD_POLICY, Config::CACHE_LINE_SIZE> blocks_;
+    
+    // Stack of the code that called into the memory manager (this frame is skipped)
+    static MEMORY_NO_INLINE memory_uint32_t capture_stack_id() {
+        void* frames[MemoryStackTable::MAX_DEPTH];
+        const int depth = memory_os_walk_frames(frames, MemoryStackTable::MAX_DEPTH, 1);
+        return MemoryStackTable::intern(frames, depth);
+    }
+    
+public:
+    // Blocks are accounted in track_block/untrack_block, which see their addresses
+    static MEMORY_ALWAYS_INLINE void track_allocation([[maybe_unused]] memory_size_t size, [[maybe_unused]] const char* file = nullptr, [[maybe_unused]] int line = 0, [[maybe_unused]] const char* function = nullptr) {
+    }
+    
+    static MEMORY_ALWAYS_INLINE void track_deallocation([[maybe_unused]] memory_size_t size, [[maybe_unused]] const char* file = nullptr, [[maybe_unused]] int line = 0, [[maybe_unused]] const char* function = nullptr) {
+    }
+    
+    static MEMORY_ALWAYS_INLINE void track_reallocation([[maybe_unused]] memory_size_t old_size, [[maybe_unused]] memory_size_t new_size, [[maybe_unused]] const char* file = nullptr, [[maybe_unused]] int line = 0, [[maybe_unused]] const char* function = nullptr) {
+        if constexpr (Config::ENABLE_TRACKING) {
+            Stats::on_reallocation(1, 0, 0);
+        }
+    }
+    
+    static MEMORY_ALWAYS_INLINE void track_allocation_batch([[maybe_unused]] memory_size_t total_size, [[maybe_unused]] memory_size_t count, [[maybe_unused]] const char* file = nullptr, [[maybe_unused]] int line = 0, [[maybe_unused]] const char* function = nullptr) {
+    }
+    
+    static MEMORY_ALWAYS_INLINE void track_deallocation_batch([[maybe_unused]] memory_size_t total_size, [[maybe_unused]] memory_size_t count, [[maybe_unused]] const char* file = nullptr, [[maybe_unused]] int line = 0, [[maybe_unused]] const char* function = nullptr) {
+    }
+    
+    // Size the caller asked for, before pool rounding or padding (feeds the size histogram)
+    static MEMORY_ALWAYS_INLINE void track_request_size(memory_size_t size, memory_size_t count = 1) {
+        if constexpr (Config::ENABLE_TRACKING) {
+            Stats::on_request(size, count);
+        }
+    }
+    
+    static void track_block(void* ptr, memory_size_t size, bool p_realloc = false) {
+        if constexpr (Config::ENABLE_TRACKING) {
+            const memory_uint32_t stack_id = capture_stack_id();
+            
+            Stats::on_allocation(p_realloc ? 0 : 1, size);
+            
+            blocks_.insert(ptr, BlockRecord{ size, stack_id });
+        }
+    }
+    
+    static memory_size_t untrack_block(void* ptr, bool p_realloc = false) {
+        if constexpr (Config::ENABLE_TRACKING) {
+            BlockRecord record;
+            if (!blocks_.remove(ptr, &record)) {
+                return 0;
+            }
+            Stats::on_deallocation(p_realloc ? 0 : 1, record.size);
+            return record.size;
+        }
+        else {
+            return 0;
+        }
+    }
+    
+    // Live bytes per allocating stack, largest first
+    static std::vector<StackUsage> get_stack_usage() {
+        std::unordered_map<memory_uint32_t, StackUsage> by_stack;
+        blocks_.for_each([&by_stack](void*, const BlockRecord& record) {
+            StackUsage& usage = by_stack[record.stack_id];
+            usage.stack_id = record.stack_id;
+            usage.bytes += record.size;
+            usage.count++;
+        });
+        
+        std::vector<StackUsage> result;
+        result.reserve(by_stack.size());
+        for (const auto& entry : by_stack) {
+            result.push_back(entry.second);
+        }
+        std::sort(result.begin(), result.end(), [](const StackUsage& a, const StackUsage& b) { return a.bytes > b.bytes; });
+        return result;
+    }
+    
+    // Frames of a stack id from get_stack_usage (r_frames needs MemoryStackTable::MAX_DEPTH slots)
+    static int get_stack(memory_uint32_t p_stack_id, void** r_frames) {
+        return MemoryStackTable::get(p_stack_id, r_frames);
+    }
+    
+    static memory_uint64_t get_current_usage() {
+        return get_stats().current_usage;
+    }
+    
+    static memory_uint64_t get_peak_usage() {
+        return get_stats().peak_usage;
+    }
+    
+    static memory_uint64_t get_allocation_count() {
+        return get_stats().allocation_count;
+    }
+    
+    static MemoryStats get_stats() {
+        return Stats::snapshot();
+    }
+    
+    static MemorySizeHistogram get_size_histogram() {
+        return Stats::size_histogram();
+    }
+    
+    static void reset_stats() {
+        Stats::reset();
+        blocks_.clear();
+    }
+    
+    // Live heap grouped by allocating stack
+    static void dump_allocations() {
+        for (const StackUsage& usage : get_stack_usage()) {
+            std::string message = "Live: " + std::to_string(usage.bytes) + " bytes in " + std::to_string(usage.count) + " blocks from";
+            void* frames[MemoryStackTable::MAX_DEPTH];
+            const int depth = get_stack(usage.stack_id, frames);
+            if (depth == 0) {
+                message += " unknown";
+            }
+            for (int i = 0; i < depth; i++) {
+                char frame[2 + 2 * sizeof(void*) + 2];
+                std::snprintf(frame, sizeof(frame), " %p", frames[i]);
+                message += frame;
+            }
+            _memory_report_error(MemoryErrorType::MEM_WARNING, MEMORY_FUNCTION_STR, __FILE__, __LINE__, message.c_str());
+        }
+    }
+};
 
+// Static member definitions would go in a .cpp file
+// For header-only implementation, we use inline static
 template<typename Config>
-inline typename DetailedMemoryTracker<Config>::CounterType DetailedMemoryTracker<Config>::next_allocation_id_{};
+inline SafeAlignedNumeric<memory_uint64_t, memory_scalar_policy(Config::THREAD_POLICY), AtomicOrderPolicy::RELAXED, Config::CACHE_LINE_SIZE> DetailedMemoryTracker<Config>::next_allocation_id_{};
 
 template<typename Config>
-inline std::mutex DetailedMemoryTracker<Config>::allocations_mutex_{};
+inline MemoryBlockTable<AllocationInfo, Config::THREAD_POLICY, Config::CACHE_LINE_SIZE> DetailedMemoryTracker<Config>::allocations_{};
 
 template<typename Config>
-inline std::unordered_map<void*, AllocationInfo> DetailedMemoryTracker<Config>::allocations_{};
+inline MemoryBlockTable<typename FullMemoryTracker<Config>::BlockRecord, Config::THREAD_POLICY, Config::CACHE_LINE_SIZE> FullMemoryTracker<Config>::blocks_{};
 
 // Type selection based on configuration
 template<typename Config>
@@ -405,6 +1431,10 @@ using MemoryTrackerType = std::conditional_t<
     std::conditional_t<
         Config::TRACKING_LEVEL == MemoryTrackingLevel::BASIC,
         BasicMemoryTracker<Config>,
-        DetailedMemoryTracker<Config>
+        std::conditional_t<
+            Config::TRACKING_LEVEL == MemoryTrackingLevel::DETAILED,
+            DetailedMemoryTracker<Config>,
+            FullMemoryTracker<Config>
+        >
     >
 >; 
\ No newline at end of file
@@ -49,7 +49,9 @@ static_assert(__cplusplus >= 201402L, "Minimum of C++14 required. Consider upgra
 // Type aliases for consistency
 using memory_size_t = std::size_t;
 using memory_uint64_t = std::uint64_t;
+using memory_int64_t = std::int64_t;
 using memory_uint32_t = std::uint32_t;
+using memory_uint16_t = std::uint16_t;
 using memory_uint8_t = std::uint8_t;
 using memory_uintptr_t = std::uintptr_t;
 
@@ -76,6 +78,19 @@ constexpr memory_uint64_t next_power_of_2(memory_uint64_t p_number) {
     return ++p_number;
 }
 
+// Index of the highest set bit (p_number must be non-zero)
+MEMORY_ALWAYS_INLINE memory_uint32_t log2_floor(memory_uint64_t p_number) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63u - static_cast<memory_uint32_t>(__builtin_clzll(p_number));
+#else
+    memory_uint32_t result = 0;
+    while (p_number >>= 1) {
+        ++result;
+    }
+    return result;
+#endif
+}
+
 // Platform-specific alignment
 #ifndef MEMORY_ALIGN
 #if defined(__GNUC__) || defined(__clang__)
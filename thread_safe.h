@@ -9,32 +9,80 @@
 
 #include "platform_defines.h"
 #include "error_handling.h"
+#include "memory_os.h"
 #include <atomic>
+#include <mutex>
 #include <type_traits>
 
+// Double-width compare-exchange for SafeStack heads: cmpxchg16b on x86-64, otherwise the
+// 16-byte __sync builtin where the compiler inlines it (AArch64). ThreadSanitizer cannot
+// follow the inline assembly, so TSan builds keep the packed single-word head.
+#ifndef MEMORY_HAS_DOUBLE_CAS
+#if defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define MEMORY_HAS_DOUBLE_CAS 0
+#endif
+#endif
+#endif
+#ifndef MEMORY_HAS_DOUBLE_CAS
+#if defined(__SANITIZE_THREAD__)
+#define MEMORY_HAS_DOUBLE_CAS 0
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define MEMORY_HAS_DOUBLE_CAS 1
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define MEMORY_HAS_DOUBLE_CAS 1
+#elif defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16) && defined(__SIZEOF_INT128__)
+#define MEMORY_HAS_DOUBLE_CAS 1
+#else
+#define MEMORY_HAS_DOUBLE_CAS 0
+#endif
+#endif
+
+#if MEMORY_HAS_DOUBLE_CAS && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 // Thread safety policies
 enum class ThreadSafetyPolicy {
     NONE,           // No thread safety, best performance
     STD_ATOMIC,     // Use std::atomic
-    CUSTOM_ATOMIC   // Use custom atomic operations
+    CUSTOM_ATOMIC   // Per-CPU sharded counters, std::atomic elsewhere
+};
+
+// Policy for values that must stay a single word, such as ids taken from increment()
+// or caps read on hot paths: CUSTOM_ATOMIC counters are sharded per CPU.
+constexpr ThreadSafetyPolicy memory_scalar_policy(ThreadSafetyPolicy p_policy) {
+    return p_policy == ThreadSafetyPolicy::CUSTOM_ATOMIC ? ThreadSafetyPolicy::STD_ATOMIC : p_policy;
+}
+
+// Memory ordering of SafeNumeric operations
+enum class AtomicOrderPolicy {
+    ACQUIRE_RELEASE, // Loads acquire, stores release, read-modify-writes acq_rel
+    RELAXED          // No ordering; for counters that never publish other data
 };
 
 // Forward declarations
-template<typename T, ThreadSafetyPolicy Policy = ThreadSafetyPolicy::STD_ATOMIC>
+template<typename T, ThreadSafetyPolicy Policy = ThreadSafetyPolicy::STD_ATOMIC, AtomicOrderPolicy Order = AtomicOrderPolicy::ACQUIRE_RELEASE>
 class SafeNumeric;
 
 template<ThreadSafetyPolicy Policy = ThreadSafetyPolicy::STD_ATOMIC>
 class SafeFlag;
 
+template<ThreadSafetyPolicy Policy = ThreadSafetyPolicy::STD_ATOMIC>
+class SafeLock;
+
+template<ThreadSafetyPolicy Policy = ThreadSafetyPolicy::STD_ATOMIC, memory_size_t LinkIndex = 0>
+class SafeStack;
+
 // No thread safety implementation
-template<typename T>
-class SafeNumeric<T, ThreadSafetyPolicy::NONE> {
+template<typename T, AtomicOrderPolicy Order>
+class SafeNumeric<T, ThreadSafetyPolicy::NONE, Order> {
 private:
     T value;
 
 public:
-    SafeNumeric() : value(T{}) {}
-    SafeNumeric(T initial_value) : value(initial_value) {}
+    constexpr SafeNumeric() : value(T{}) {}
+    constexpr SafeNumeric(T initial_value) : value(initial_value) {}
 
     MEMORY_ALWAYS_INLINE void set(T p_value) {
         value = p_value;
@@ -98,62 +146,67 @@ public:
 };
 
 // std::atomic implementation
-template<typename T>
-class SafeNumeric<T, ThreadSafetyPolicy::STD_ATOMIC> {
+template<typename T, AtomicOrderPolicy Order>
+class SafeNumeric<T, ThreadSafetyPolicy::STD_ATOMIC, Order> {
 private:
+    static constexpr bool RELAXED = Order == AtomicOrderPolicy::RELAXED;
+    static constexpr std::memory_order LOAD_ORDER = RELAXED ? std::memory_order_relaxed : std::memory_order_acquire;
+    static constexpr std::memory_order STORE_ORDER = RELAXED ? std::memory_order_relaxed : std::memory_order_release;
+    static constexpr std::memory_order RMW_ORDER = RELAXED ? std::memory_order_relaxed : std::memory_order_acq_rel;
+
     std::atomic<T> value;
 
     // C++14 compatible check for lock-free atomic operations
     static_assert(std::is_trivially_copyable<T>::value, "Type must be trivially copyable for atomic operations");
 
 public:
-    SafeNumeric() : value(T{}) {}
-    SafeNumeric(T initial_value) : value(initial_value) {}
+    constexpr SafeNumeric() : value(T{}) {}
+    constexpr SafeNumeric(T initial_value) : value(initial_value) {}
 
     MEMORY_ALWAYS_INLINE void set(T p_value) {
-        value.store(p_value, std::memory_order_release);
+        value.store(p_value, STORE_ORDER);
     }
 
     MEMORY_ALWAYS_INLINE T get() const {
-        return value.load(std::memory_order_acquire);
+        return value.load(LOAD_ORDER);
     }
 
     MEMORY_ALWAYS_INLINE T increment() {
-        return value.fetch_add(1, std::memory_order_acq_rel) + 1;
+        return value.fetch_add(1, RMW_ORDER) + 1;
     }
 
     MEMORY_ALWAYS_INLINE T postincrement() {
-        return value.fetch_add(1, std::memory_order_acq_rel);
+        return value.fetch_add(1, RMW_ORDER);
     }
 
     MEMORY_ALWAYS_INLINE T decrement() {
-        return value.fetch_sub(1, std::memory_order_acq_rel) - 1;
+        return value.fetch_sub(1, RMW_ORDER) - 1;
     }
 
     MEMORY_ALWAYS_INLINE T postdecrement() {
-        return value.fetch_sub(1, std::memory_order_acq_rel);
+        return value.fetch_sub(1, RMW_ORDER);
     }
 
     MEMORY_ALWAYS_INLINE T add(T p_value) {
-        return value.fetch_add(p_value, std::memory_order_acq_rel) + p_value;
+        return value.fetch_add(p_value, RMW_ORDER) + p_value;
     }
 
     MEMORY_ALWAYS_INLINE T postadd(T p_value) {
-        return value.fetch_add(p_value, std::memory_order_acq_rel);
+        return value.fetch_add(p_value, RMW_ORDER);
     }
 
     MEMORY_ALWAYS_INLINE T sub(T p_value) {
-        return value.fetch_sub(p_value, std::memory_order_acq_rel) - p_value;
+        return value.fetch_sub(p_value, RMW_ORDER) - p_value;
     }
 
     MEMORY_ALWAYS_INLINE T postsub(T p_value) {
-        return value.fetch_sub(p_value, std::memory_order_acq_rel);
+        return value.fetch_sub(p_value, RMW_ORDER);
     }
 
     MEMORY_ALWAYS_INLINE T exchange_if_greater(T p_value) {
-        T current = value.load(std::memory_order_acquire);
+        T current = value.load(LOAD_ORDER);
         while (p_value > current) {
-            if (value.compare_exchange_weak(current, p_value, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            if (value.compare_exchange_weak(current, p_value, RMW_ORDER, LOAD_ORDER)) {
                 return p_value;
             }
         }
@@ -161,9 +214,9 @@ public:
     }
 
     MEMORY_ALWAYS_INLINE T conditional_increment() {
-        T current = value.load(std::memory_order_acquire);
+        T current = value.load(LOAD_ORDER);
         while (current != 0) {
-            if (value.compare_exchange_weak(current, current + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            if (value.compare_exchange_weak(current, current + 1, RMW_ORDER, LOAD_ORDER)) {
                 return current + 1;
             }
         }
@@ -171,11 +224,133 @@ public:
     }
 };
 
-// Custom atomic implementation (placeholder for platform-specific optimizations)
-template<typename T>
-class SafeNumeric<T, ThreadSafetyPolicy::CUSTOM_ATOMIC> : public SafeNumeric<T, ThreadSafetyPolicy::STD_ATOMIC> {
-    // For now, delegate to std::atomic
-    // Can be specialized for specific platforms/types if needed
+// Per-CPU sharded counter, in the style of the Linux percpu_counter
+// Updates land in the shard of the CPU the thread runs on (see memory_os_current_cpu), so
+// writers on different cores touch different cache lines. A shard's delta is folded into
+// the shared total once it passes FOLD_THRESHOLD. get() sums every shard; the values
+// returned by add(), increment() and friends are the folded total plus the caller's shard,
+// so they may trail the true value by up to FOLD_THRESHOLD per shard.
+// exchange_if_greater() and conditional_increment() act on the folded total alone: use them
+// on counters that are never add()-ed (peaks), and memory_scalar_policy() for ids and caps.
+template<typename T, AtomicOrderPolicy Order>
+class SafeNumeric<T, ThreadSafetyPolicy::CUSTOM_ATOMIC, Order> {
+    static_assert(std::is_integral<T>::value, "Per-CPU counters need an integral type");
+
+public:
+    static constexpr memory_uint32_t SHARD_COUNT = 64;
+
+private:
+    using SignedType = std::make_signed_t<T>;
+
+    static constexpr SignedType FOLD_THRESHOLD = sizeof(T) >= 4 ? 64 * 1024 : 16;
+    static constexpr bool RELAXED = Order == AtomicOrderPolicy::RELAXED;
+    static constexpr std::memory_order LOAD_ORDER = RELAXED ? std::memory_order_relaxed : std::memory_order_acquire;
+    static constexpr std::memory_order STORE_ORDER = RELAXED ? std::memory_order_relaxed : std::memory_order_release;
+    static constexpr std::memory_order RMW_ORDER = RELAXED ? std::memory_order_relaxed : std::memory_order_acq_rel;
+
+    struct alignas(64) Shard {
+        std::atomic<T> delta;
+    };
+
+    alignas(64) std::atomic<T> total;
+    Shard shards[SHARD_COUNT];
+
+    // Threads on platforms without a CPU id spread over the shards by arrival order
+    static MEMORY_ALWAYS_INLINE memory_uint32_t shard_index() {
+        const int cpu = memory_os_current_cpu();
+        if (MEMORY_LIKELY(cpu >= 0)) {
+            return static_cast<memory_uint32_t>(cpu) & (SHARD_COUNT - 1);
+        }
+        static std::atomic<memory_uint32_t> next_thread{ 0 };
+        static thread_local memory_uint32_t thread_index = next_thread.fetch_add(1, std::memory_order_relaxed);
+        return thread_index & (SHARD_COUNT - 1);
+    }
+
+public:
+    constexpr SafeNumeric() : total(T{}), shards{} {}
+    constexpr SafeNumeric(T initial_value) : total(initial_value), shards{} {}
+
+    MEMORY_ALWAYS_INLINE void set(T p_value) {
+        for (Shard& shard : shards) {
+            shard.delta.store(T{}, std::memory_order_relaxed);
+        }
+        total.store(p_value, STORE_ORDER);
+    }
+
+    MEMORY_ALWAYS_INLINE T get() const {
+        T value = total.load(LOAD_ORDER);
+        for (const Shard& shard : shards) {
+            value += shard.delta.load(LOAD_ORDER);
+        }
+        return value;
+    }
+
+    MEMORY_ALWAYS_INLINE T add(T p_value) {
+        Shard& shard = shards[shard_index()];
+        const T delta = static_cast<T>(shard.delta.fetch_add(p_value, RMW_ORDER) + p_value);
+        if (MEMORY_UNLIKELY(static_cast<SignedType>(delta) > FOLD_THRESHOLD || static_cast<SignedType>(delta) < -FOLD_THRESHOLD)) {
+            const T folded = shard.delta.exchange(T{}, RMW_ORDER);
+            return static_cast<T>(total.fetch_add(folded, RMW_ORDER) + folded);
+        }
+        return static_cast<T>(total.load(LOAD_ORDER) + delta);
+    }
+
+    MEMORY_ALWAYS_INLINE T postadd(T p_value) {
+        return static_cast<T>(add(p_value) - p_value);
+    }
+
+    MEMORY_ALWAYS_INLINE T sub(T p_value) {
+        return add(static_cast<T>(T{} - p_value));
+    }
+
+    MEMORY_ALWAYS_INLINE T postsub(T p_value) {
+        return static_cast<T>(sub(p_value) + p_value);
+    }
+
+    MEMORY_ALWAYS_INLINE T increment() {
+        return add(1);
+    }
+
+    MEMORY_ALWAYS_INLINE T postincrement() {
+        return postadd(1);
+    }
+
+    MEMORY_ALWAYS_INLINE T decrement() {
+        return sub(1);
+    }
+
+    MEMORY_ALWAYS_INLINE T postdecrement() {
+        return postsub(1);
+    }
+
+    MEMORY_ALWAYS_INLINE T exchange_if_greater(T p_value) {
+        T current = total.load(LOAD_ORDER);
+        while (p_value > current) {
+            if (total.compare_exchange_weak(current, p_value, RMW_ORDER, LOAD_ORDER)) {
+                return p_value;
+            }
+        }
+        return current;
+    }
+
+    MEMORY_ALWAYS_INLINE T conditional_increment() {
+        T current = total.load(LOAD_ORDER);
+        while (current != 0) {
+            if (total.compare_exchange_weak(current, static_cast<T>(current + 1), RMW_ORDER, LOAD_ORDER)) {
+                return static_cast<T>(current + 1);
+            }
+        }
+        return 0;
+    }
+};
+
+// SafeNumeric padded out to its own cache line, for shared counters written on hot paths
+// Unsynchronized (NONE) counters are never written concurrently and stay unpadded.
+template<typename T, ThreadSafetyPolicy Policy = ThreadSafetyPolicy::STD_ATOMIC, AtomicOrderPolicy Order = AtomicOrderPolicy::ACQUIRE_RELEASE, memory_size_t CacheLineSize = 64>
+class alignas(Policy == ThreadSafetyPolicy::NONE ? alignof(SafeNumeric<T, Policy, Order>) : CacheLineSize) SafeAlignedNumeric
+    : public SafeNumeric<T, Policy, Order> {
+public:
+    using SafeNumeric<T, Policy, Order>::SafeNumeric;
 };
 
 // SafeFlag implementations
@@ -185,7 +360,7 @@ private:
     bool flag;
 
 public:
-    SafeFlag() : flag(false) {}
+    constexpr SafeFlag() : flag(false) {}
 
     MEMORY_ALWAYS_INLINE void set() {
         flag = true;
@@ -212,7 +387,7 @@ private:
     std::atomic<bool> flag;
 
 public:
-    SafeFlag() : flag(false) {}
+    constexpr SafeFlag() : flag(false) {}
 
     MEMORY_ALWAYS_INLINE void set() {
         flag.store(true, std::memory_order_release);
@@ -236,12 +411,265 @@ class SafeFlag<ThreadSafetyPolicy::CUSTOM_ATOMIC> : public SafeFlag<ThreadSafety
     // For now, delegate to std::atomic
 };
 
+// SafeLock implementations (usable with std::lock_guard)
+template<>
+class SafeLock<ThreadSafetyPolicy::NONE> {
+public:
+    MEMORY_ALWAYS_INLINE void lock() {}
+    MEMORY_ALWAYS_INLINE bool try_lock() { return true; }
+    MEMORY_ALWAYS_INLINE void unlock() {}
+};
+
+template<>
+class SafeLock<ThreadSafetyPolicy::STD_ATOMIC> {
+private:
+    std::mutex mutex;
+
+public:
+    MEMORY_ALWAYS_INLINE void lock() {
+        mutex.lock();
+    }
+
+    MEMORY_ALWAYS_INLINE bool try_lock() {
+        return mutex.try_lock();
+    }
+
+    MEMORY_ALWAYS_INLINE void unlock() {
+        mutex.unlock();
+    }
+};
+
+template<>
+class SafeLock<ThreadSafetyPolicy::CUSTOM_ATOMIC> : public SafeLock<ThreadSafetyPolicy::STD_ATOMIC> {
+    // For now, delegate to std::mutex
+};
+
+// SafeStack implementations: intrusive LIFO of raw memory nodes
+// Each node stores the link to the next node in its pointer-sized word at LinkIndex.
+template<memory_size_t LinkIndex>
+class SafeStack<ThreadSafetyPolicy::NONE, LinkIndex> {
+private:
+    void* top;
+
+    static MEMORY_ALWAYS_INLINE void*& link(void* p_node) {
+        return static_cast<void**>(p_node)[LinkIndex];
+    }
+
+public:
+    constexpr SafeStack() : top(nullptr) {}
+
+    MEMORY_ALWAYS_INLINE void push(void* p_node) {
+        push_chain(p_node, p_node);
+    }
+
+    // Push p_first..p_last, already linked through LinkIndex, as one operation
+    MEMORY_ALWAYS_INLINE void push_chain(void* p_first, void* p_last) {
+        link(p_last) = top;
+        top = p_first;
+    }
+
+    MEMORY_ALWAYS_INLINE void* pop() {
+        void* node = top;
+        if (node) {
+            top = link(node);
+        }
+        return node;
+    }
+
+    // Detach the whole stack, returning its former top
+    MEMORY_ALWAYS_INLINE void* pop_all() {
+        void* node = top;
+        top = nullptr;
+        return node;
+    }
+
+    MEMORY_ALWAYS_INLINE void* pop_all_synchronized() {
+        return pop_all();
+    }
+
+    MEMORY_ALWAYS_INLINE bool is_empty() const {
+        return top == nullptr;
+    }
+};
+
+// Lock-free Treiber stack; the head pairs the top pointer with a modification
+// tag that changes on every update so a stale compare-exchange fails (ABA).
+// Nodes may be read after another thread popped them, so their memory must
+// stay mapped for as long as the stack is in use.
+template<memory_size_t LinkIndex>
+class SafeStack<ThreadSafetyPolicy::STD_ATOMIC, LinkIndex> {
+private:
+#if MEMORY_HAS_DOUBLE_CAS
+    // Full pointer and a 64-bit tag, swapped together by one double-width compare-exchange
+    struct alignas(16) Head {
+        std::atomic<void*> top{ nullptr };
+        std::atomic<memory_uint64_t> tag{ 0 };
+    };
+
+    static_assert(sizeof(std::atomic<void*>) == 8 && sizeof(std::atomic<memory_uint64_t>) == 8, "SafeStack head must be two words");
+
+    Head head;
+
+    // A torn read is harmless: the compare-exchange checks both words
+    MEMORY_ALWAYS_INLINE void load_head(void*& r_top, memory_uint64_t& r_tag) const {
+        r_tag = head.tag.load(std::memory_order_acquire);
+        r_top = head.top.load(std::memory_order_acquire);
+    }
+
+    // Replace {r_top, r_tag} with {p_top, r_tag + 1}; on failure r_top and r_tag receive the current head
+    MEMORY_ALWAYS_INLINE bool exchange_head(void*& r_top, memory_uint64_t& r_tag, void* p_top) {
+        const memory_uint64_t tag = r_tag + 1;
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+        bool exchanged;
+        __asm__ __volatile__("lock cmpxchg16b %1"
+                : "=@ccz"(exchanged), "+m"(head), "+a"(r_top), "+d"(r_tag)
+                : "b"(p_top), "c"(tag)
+                : "memory");
+        return exchanged;
+#elif defined(_MSC_VER)
+        __int64 comparand[2] = { reinterpret_cast<__int64>(r_top), static_cast<__int64>(r_tag) };
+        const bool exchanged = _InterlockedCompareExchange128(reinterpret_cast<volatile __int64*>(&head),
+                static_cast<__int64>(tag), reinterpret_cast<__int64>(p_top), comparand) != 0;
+        r_top = reinterpret_cast<void*>(comparand[0]);
+        r_tag = static_cast<memory_uint64_t>(comparand[1]);
+        return exchanged;
+#else
+        __extension__ typedef unsigned __int128 Pair;
+        const Pair expected = (static_cast<Pair>(r_tag) << 64) | reinterpret_cast<memory_uintptr_t>(r_top);
+        const Pair desired = (static_cast<Pair>(tag) << 64) | reinterpret_cast<memory_uintptr_t>(p_top);
+        const Pair previous = __sync_val_compare_and_swap(reinterpret_cast<Pair*>(&head), expected, desired);
+        r_top = reinterpret_cast<void*>(static_cast<memory_uintptr_t>(previous));
+        r_tag = static_cast<memory_uint64_t>(previous >> 64);
+        return previous == expected;
+#endif
+    }
+#else
+    // Without a double-width compare-exchange the pointer is packed into one word with the tag.
+    // 64-bit: 48-bit user addresses, 8-byte aligned nodes -> 45 pointer bits, 19 tag bits
+    // 32-bit: full pointer in the low half, tag in the high half
+    static constexpr memory_uint32_t POINTER_SHIFT = sizeof(void*) == 8 ? 3 : 0;
+    static constexpr memory_uint32_t POINTER_BITS = sizeof(void*) == 8 ? 45 : 32;
+    static constexpr memory_uint64_t POINTER_MASK = (memory_uint64_t(1) << POINTER_BITS) - 1;
+    static constexpr memory_uint64_t TAG_INCREMENT = memory_uint64_t(1) << POINTER_BITS;
+
+    std::atomic<memory_uint64_t> head{ 0 };
+
+    static_assert(std::atomic<memory_uint64_t>::is_always_lock_free, "SafeStack requires a lock-free 64-bit compare-exchange");
+
+    static MEMORY_ALWAYS_INLINE void* pointer_of(memory_uint64_t p_head) {
+        return reinterpret_cast<void*>(static_cast<memory_uintptr_t>((p_head & POINTER_MASK) << POINTER_SHIFT));
+    }
+
+    // r_tag holds the whole packed word
+    MEMORY_ALWAYS_INLINE void load_head(void*& r_top, memory_uint64_t& r_tag) const {
+        r_tag = head.load(std::memory_order_acquire);
+        r_top = pointer_of(r_tag);
+    }
+
+    MEMORY_ALWAYS_INLINE bool exchange_head(void*& r_top, memory_uint64_t& r_tag, void* p_top) {
+        // Checked in every build: a node outside the packed range (5-level paging, tagged
+        // pointers) would silently corrupt the stack
+        const memory_uintptr_t address = reinterpret_cast<memory_uintptr_t>(p_top);
+        if (MEMORY_UNLIKELY(((static_cast<memory_uint64_t>(address) >> POINTER_SHIFT) & ~POINTER_MASK) != 0 ||
+                            (address & ((memory_uintptr_t(1) << POINTER_SHIFT) - 1)) != 0)) {
+            MEMORY_CRASH_NOW_MSG("SafeStack node address does not fit the packed head.");
+        }
+        const memory_uint64_t packed = ((r_tag & ~POINTER_MASK) + TAG_INCREMENT) | (static_cast<memory_uint64_t>(address) >> POINTER_SHIFT);
+        if (head.compare_exchange_weak(r_tag, packed, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return true;
+        }
+        r_top = pointer_of(r_tag);
+        return false;
+    }
+#endif
+
+    static MEMORY_ALWAYS_INLINE void*& link(void* p_node) {
+        return static_cast<void**>(p_node)[LinkIndex];
+    }
+
+public:
+    constexpr SafeStack() = default;
+
+    MEMORY_ALWAYS_INLINE void push(void* p_node) {
+        push_chain(p_node, p_node);
+    }
+
+    // Push p_first..p_last, already linked through LinkIndex, with a single compare-exchange
+    MEMORY_ALWAYS_INLINE void push_chain(void* p_first, void* p_last) {
+        void* top;
+        memory_uint64_t tag;
+        load_head(top, tag);
+        do {
+            // Atomic because a pop racing with an earlier pop may still read this node's link
+            reinterpret_cast<std::atomic<void*>*>(&link(p_last))->store(top, std::memory_order_relaxed);
+        } while (!exchange_head(top, tag, p_first));
+    }
+
+    MEMORY_ALWAYS_INLINE void* pop() {
+        void* top;
+        memory_uint64_t tag;
+        load_head(top, tag);
+        while (top != nullptr) {
+            // May read a node another thread just popped; the tag makes the exchange fail then
+            void* next = reinterpret_cast<std::atomic<void*>*>(&link(top))->load(std::memory_order_relaxed);
+            void* node = top;
+            if (exchange_head(top, tag, next)) {
+                return node;
+            }
+        }
+        return nullptr;
+    }
+
+    // Detach the whole stack, returning its former top
+    MEMORY_ALWAYS_INLINE void* pop_all() {
+        void* top;
+        memory_uint64_t tag;
+        load_head(top, tag);
+        while (top != nullptr) {
+            void* node = top;
+            if (exchange_head(top, tag, nullptr)) {
+                return node;
+            }
+        }
+        return nullptr;
+    }
+
+    // pop_all() that writes the head even when the stack is empty, so every later push
+    // synchronizes with it and sees whatever the caller did before
+    MEMORY_ALWAYS_INLINE void* pop_all_synchronized() {
+        void* top;
+        memory_uint64_t tag;
+        load_head(top, tag);
+        for (;;) {
+            void* node = top;
+            if (exchange_head(top, tag, nullptr)) {
+                return node;
+            }
+        }
+    }
+
+    MEMORY_ALWAYS_INLINE bool is_empty() const {
+        void* top;
+        memory_uint64_t tag;
+        load_head(top, tag);
+        return top == nullptr;
+    }
+};
+
+template<memory_size_t LinkIndex>
+class SafeStack<ThreadSafetyPolicy::CUSTOM_ATOMIC, LinkIndex> : public SafeStack<ThreadSafetyPolicy::STD_ATOMIC, LinkIndex> {
+    // For now, delegate to the tagged std::atomic implementation
+};
+
 // Type traits for safe numeric types
 template<typename T>
 struct is_safe_numeric : std::false_type {};
 
-template<typename T, ThreadSafetyPolicy Policy>
-struct is_safe_numeric<SafeNumeric<T, Policy>> : std::true_type {};
+template<typename T, ThreadSafetyPolicy Policy, AtomicOrderPolicy Order>
+struct is_safe_numeric<SafeNumeric<T, Policy, Order>> : std::true_type {};
+
+template<typename T, ThreadSafetyPolicy Policy, AtomicOrderPolicy Order, memory_size_t CacheLineSize>
+struct is_safe_numeric<SafeAlignedNumeric<T, Policy, Order, CacheLineSize>> : std::true_type {};
 
 template<typename T>
 inline constexpr bool is_safe_numeric_v = is_safe_numeric<T>::value;